@@ -0,0 +1,18 @@
+// OpsTrack_AIGroup.c
+// Registers AI groups with the OpsTrack entity registry as they spawn
+
+modded class SCR_AIGroup
+{
+	override void EOnInit(IEntity owner)
+	{
+		super.EOnInit(owner);
+
+		if (!Replication.IsServer())
+			return;
+
+		// Members are read from the group on capture, so units added later are picked up as well
+		OpsTrack_EntityManager entityMgr = OpsTrack_EntityManager.Get();
+		if (entityMgr)
+			entityMgr.TrackAiGroup(this);
+	}
+}
@@ -1,5 +1,6 @@
 // OpsTrack_BaseGameMode.c
 // Hooks into SCR_BaseGameMode for player connection and kill tracking
+// Also maintains the tracked-entity registry (spawn, possession, death, disconnect)
 
 modded class SCR_BaseGameMode
 {
@@ -85,6 +86,13 @@ modded class SCR_BaseGameMode
 			m_ConnectionEvents.SendLeave(playerId);
 		}
 
+		if (Replication.IsServer())
+		{
+			OpsTrackManager manager = OpsTrackManager.GetIfExists();
+			if (manager && manager.GetEntityManager())
+				manager.GetEntityManager().UntrackPlayer(playerId);
+		}
+
 		super.OnPlayerDisconnected(playerId, cause, timeout);
 	}
 	
@@ -98,6 +106,9 @@ modded class SCR_BaseGameMode
 		if (!entity)
 			return;
 
+		// New body: name and components are resolved again on next use
+		OpsTrack_EntityUtils.Invalidate(entity);
+
 		OpsTrackManager manager = OpsTrackManager.Get();
 		if (!manager)
 			return;
@@ -118,6 +129,29 @@ modded class SCR_BaseGameMode
 			factionName = faction.GetFactionName();
 
 		entityMgr.GetOrCreatePlayerEntity(playerId, playerName, factionName);
+		entityMgr.TrackPlayerEntity(playerId, entity);
+	}
+
+	// Called when a player takes or releases control of an entity (Game Master possession, respawn)
+	override void OnPlayerEntityChanged_S(int playerId, IEntity previousEntity, IEntity newEntity)
+	{
+		super.OnPlayerEntityChanged_S(playerId, previousEntity, newEntity);
+
+		if (!Replication.IsServer() || playerId <= 0)
+			return;
+
+		// The player name moves with control (Game Master possession)
+		OpsTrack_EntityUtils.Invalidate(previousEntity);
+		OpsTrack_EntityUtils.Invalidate(newEntity);
+
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (!manager || !manager.GetEntityManager())
+			return;
+
+		if (newEntity)
+			manager.GetEntityManager().TrackPlayerEntity(playerId, newEntity);
+		else
+			manager.GetEntityManager().DetachPlayerEntity(playerId);
 	}
 
 	
@@ -128,10 +162,22 @@ modded class SCR_BaseGameMode
 		
 		if (!Replication.IsServer())
 			return;
+
+		// Tracked record keeps capturing, but as dead
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (manager && manager.GetEntityManager())
+			manager.GetEntityManager().MarkDead(entity);
 		
-		if (!m_KillEventsEnabled || !m_CombatEvents)
-			return;
-		
+		if (m_KillEventsEnabled && m_CombatEvents)
+			SendDeathEvent(entity, killerEntity, instigator);
+
+		// Resolved after this only if a queued event still names it (the entry is checked by EntityID)
+		OpsTrack_EntityUtils.Invalidate(entity);
+	}
+
+	// Kill or self-harm event for a destroyed controllable
+	protected void SendDeathEvent(IEntity entity, IEntity killerEntity, notnull Instigator instigator)
+	{
 		// Get player ID (0 for AI)
 		int victimPlayerId = 0;
 		if (GetGame() && GetGame().GetPlayerManager())
@@ -0,0 +1,74 @@
+// OpsTrack_BatchPacker.c
+// Byte budget for one /batch payload, shared by all of its sections
+// The builder writes sections in priority order; each item is written straight into the payload
+// and cut off again if it doesn't fit, which closes the batch - everything after it carries over.
+// The string table block goes last and grows while records intern, so its size is kept in reserve.
+
+class OpsTrack_BatchPacker
+{
+	protected OpsTrack_PayloadWriter m_Writer;
+	protected OpsTrack_StringTable m_Strings;   // null if the batch has no string table
+	protected int m_StringBase;
+	protected int m_Budget;
+	protected int m_Items;                      // Items accepted in this batch
+	protected bool m_Full;
+
+	private static const int TAIL_RESERVE_BYTES = 128;   // Keys of the sections still to come and the closing brace
+
+	void Begin(OpsTrack_PayloadWriter writer, int budget, OpsTrack_StringTable strings, int stringBase)
+	{
+		m_Writer = writer;
+		m_Budget = budget;
+		m_Strings = strings;
+		m_StringBase = stringBase;
+		m_Items = 0;
+		m_Full = false;
+	}
+
+	// Another item may be tried
+	bool HasRoom()
+	{
+		return !m_Full && GetRoom() > 0;
+	}
+
+	// Bytes left for items
+	int GetRoom()
+	{
+		int reserve = TAIL_RESERVE_BYTES;
+		if (m_Strings)
+			reserve += m_Strings.GetBytesFrom(m_StringBase);
+		return m_Budget - m_Writer.Length() - reserve;
+	}
+
+	// An item (or block) was written from mark on: keep it if it fits, otherwise cut it and close the batch.
+	// The first item is always kept so an oversized one can't block its queue.
+	bool Accept(int mark)
+	{
+		if (GetRoom() >= 0 || m_Items == 0)
+		{
+			m_Items++;
+			return true;
+		}
+
+		m_Writer.Truncate(mark);
+		m_Full = true;
+		return false;
+	}
+
+	// Cut a block that didn't fit without closing the batch (the caller retries it smaller)
+	void Rollback(int mark)
+	{
+		m_Writer.Truncate(mark);
+	}
+
+	// Nothing more goes into this batch
+	void Close()
+	{
+		m_Full = true;
+	}
+
+	bool IsFull()
+	{
+		return m_Full;
+	}
+}
@@ -0,0 +1,105 @@
+// OpsTrack_CircuitBreaker.c
+// Closed / open / half-open circuit breaker for the OpsTrack API
+// Each consecutive failure doubles the cooldown (with jitter so many servers don't retry in lockstep).
+// When the cooldown expires a single probe is allowed; success closes the circuit immediately.
+
+class OpsTrack_CircuitBreaker
+{
+	protected OpsTrack_CircuitState m_State;
+	protected int m_ConsecutiveFailures;
+	protected int m_OpenUntilTick;
+	protected int m_LastCooldownMs;
+
+	private static const int BASE_COOLDOWN_MS = 2000;    // First failure
+	private static const int MAX_COOLDOWN_MS = 120000;   // Ceiling (the old fixed backoff)
+	private static const float JITTER_FRACTION = 0.5;    // Up to half the cooldown is randomized
+
+	void OpsTrack_CircuitBreaker()
+	{
+		m_State = OpsTrack_CircuitState.CLOSED;
+		m_ConsecutiveFailures = 0;
+		m_OpenUntilTick = 0;
+		m_LastCooldownMs = 0;
+	}
+
+	OpsTrack_CircuitState GetState()
+	{
+		return m_State;
+	}
+
+	bool IsClosed()
+	{
+		return m_State == OpsTrack_CircuitState.CLOSED;
+	}
+
+	int GetConsecutiveFailures()
+	{
+		return m_ConsecutiveFailures;
+	}
+
+	// Milliseconds until a probe is allowed (0 when closed or ready to probe)
+	int GetCooldownRemainingMs()
+	{
+		if (m_State != OpsTrack_CircuitState.OPEN)
+			return 0;
+
+		int remaining = m_OpenUntilTick - System.GetTickCount();
+		if (remaining < 0)
+			return 0;
+		return remaining;
+	}
+
+	// True exactly once per cooldown: moves OPEN -> HALF_OPEN and lets the caller send a probe
+	bool TryStartProbe()
+	{
+		if (m_State != OpsTrack_CircuitState.OPEN)
+			return false;
+
+		if (System.GetTickCount() < m_OpenUntilTick)
+			return false;
+
+		m_State = OpsTrack_CircuitState.HALF_OPEN;
+		OpsTrackLogger.Info(string.Format("Circuit half-open: probing API after %1 failure(s)", m_ConsecutiveFailures));
+		return true;
+	}
+
+	void OnSuccess()
+	{
+		if (m_State != OpsTrack_CircuitState.CLOSED)
+			OpsTrackLogger.Info(string.Format("Circuit closed: API reachable again after %1 failure(s)", m_ConsecutiveFailures));
+
+		m_State = OpsTrack_CircuitState.CLOSED;
+		m_ConsecutiveFailures = 0;
+	}
+
+	void OnFailure()
+	{
+		// Late failures from requests sent before the circuit opened don't extend the cooldown
+		if (m_State == OpsTrack_CircuitState.OPEN)
+			return;
+
+		m_ConsecutiveFailures++;
+		m_LastCooldownMs = ComputeCooldownMs(m_ConsecutiveFailures);
+		m_OpenUntilTick = System.GetTickCount() + m_LastCooldownMs;
+		m_State = OpsTrack_CircuitState.OPEN;
+
+		OpsTrackLogger.Warn(string.Format("Circuit open: API unavailable (failure %1). Probing again in %2 ms.",
+			m_ConsecutiveFailures, m_LastCooldownMs));
+	}
+
+	// Exponential cooldown with "equal jitter": half fixed, half random
+	protected int ComputeCooldownMs(int failures)
+	{
+		int cooldown = BASE_COOLDOWN_MS;
+		for (int i = 1; i < failures && cooldown < MAX_COOLDOWN_MS; i++)
+		{
+			cooldown = cooldown * 2;
+		}
+
+		if (cooldown > MAX_COOLDOWN_MS)
+			cooldown = MAX_COOLDOWN_MS;
+
+		float jitter = cooldown * JITTER_FRACTION;
+		return cooldown - Math.Round(Math.RandomFloat(0, jitter));
+	}
+}
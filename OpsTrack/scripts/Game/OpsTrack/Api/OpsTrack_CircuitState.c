@@ -0,0 +1,8 @@
+// OpsTrack_CircuitState.c
+
+enum OpsTrack_CircuitState
+{
+	CLOSED,     // Requests flow normally
+	OPEN,       // API considered down - nothing is sent until the cooldown expires
+	HALF_OPEN   // Cooldown expired - a single probe decides whether to close or re-open
+}
@@ -0,0 +1,129 @@
+// OpsTrack_ColumnarStateWriter.c
+// Writes queued entity states as a columnar block instead of one object per sample
+// Field names appear once per batch and each entity UUID once; samples refer to it by index.
+//
+//   "stateColumns":{
+//     "entityIds":["<uuid>",...],       - entity table for this batch
+//     "entity":[0,1,0,...],             - index into entityIds per sample
+//     "timestamp":[...], "posX":[...], "posY":[...], "posZ":[...], "rotation":[...],
+//     "isAlive":[1,0,...]               - 1/0 instead of true/false
+//   }
+// Positions and rotation are rounded like every other record (OpsTrack_JsonWriter decimals).
+
+class OpsTrack_ColumnarStateWriter
+{
+	// Scratch space reused between batches
+	protected ref map<string, int> m_EntityIndex;
+	protected ref array<string> m_EntityIds;
+	protected ref array<int> m_SampleEntity;
+
+	void OpsTrack_ColumnarStateWriter()
+	{
+		m_EntityIndex = new map<string, int>();
+		m_EntityIds = new array<string>();
+		m_SampleEntity = new array<int>();
+	}
+
+	// Write the oldest count states of the queue as "stateColumns":{...}
+	void Write(OpsTrack_PayloadWriter writer, OpsTrack_StateQueue states, int count)
+	{
+		if (!states)
+			count = 0;
+		else if (count > states.Count())
+			count = states.Count();
+
+		BuildEntityTable(states, count);
+
+		writer.Append("\"stateColumns\":{\"entityIds\":[");
+		for (int e = 0; e < m_EntityIds.Count(); e++)
+		{
+			if (e > 0)
+				writer.Append(",");
+			writer.AppendQuoted(m_EntityIds[e]);
+		}
+
+		writer.Append("],\"entity\":[");
+		for (int i = 0; i < count; i++)
+		{
+			if (i > 0)
+				writer.Append(",");
+			writer.Append(m_SampleEntity[i].ToString());
+		}
+
+		writer.Append("],\"timestamp\":[");
+		for (int t = 0; t < count; t++)
+		{
+			if (t > 0)
+				writer.Append(",");
+			writer.Append(states.Get(t).timestamp.ToString());
+		}
+
+		writer.Append("],\"posX\":[");
+		for (int x = 0; x < count; x++)
+		{
+			if (x > 0)
+				writer.Append(",");
+			writer.Append(OpsTrack_JsonWriter.FormatFixed(states.Get(x).posX, OpsTrack_JsonWriter.POSITION_DECIMALS));
+		}
+
+		writer.Append("],\"posY\":[");
+		for (int y = 0; y < count; y++)
+		{
+			if (y > 0)
+				writer.Append(",");
+			writer.Append(OpsTrack_JsonWriter.FormatFixed(states.Get(y).posY, OpsTrack_JsonWriter.POSITION_DECIMALS));
+		}
+
+		writer.Append("],\"posZ\":[");
+		for (int z = 0; z < count; z++)
+		{
+			if (z > 0)
+				writer.Append(",");
+			writer.Append(OpsTrack_JsonWriter.FormatFixed(states.Get(z).posZ, OpsTrack_JsonWriter.POSITION_DECIMALS));
+		}
+
+		writer.Append("],\"rotation\":[");
+		for (int r = 0; r < count; r++)
+		{
+			if (r > 0)
+				writer.Append(",");
+			writer.Append(OpsTrack_JsonWriter.FormatFixed(states.Get(r).rotation, OpsTrack_JsonWriter.ANGLE_DECIMALS));
+		}
+
+		writer.Append("],\"isAlive\":[");
+		for (int a = 0; a < count; a++)
+		{
+			if (a > 0)
+				writer.Append(",");
+			if (states.Get(a).isAlive)
+				writer.Append("1");
+			else
+				writer.Append("0");
+		}
+
+		writer.Append("]}");
+	}
+
+	// Assign each distinct entity an index in order of first appearance
+	protected void BuildEntityTable(OpsTrack_StateQueue states, int count)
+	{
+		m_EntityIndex.Clear();
+		m_EntityIds.Clear();
+		m_SampleEntity.Clear();
+
+		for (int i = 0; i < count; i++)
+		{
+			string id = string.Format("%1", states.Get(i).entityId);
+
+			int index;
+			if (!m_EntityIndex.Find(id, index))
+			{
+				index = m_EntityIds.Count();
+				m_EntityIds.Insert(id);
+				m_EntityIndex.Insert(id, index);
+			}
+
+			m_SampleEntity.Insert(index);
+		}
+	}
+}
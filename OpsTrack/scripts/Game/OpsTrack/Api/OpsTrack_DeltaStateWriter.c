@@ -0,0 +1,326 @@
+// OpsTrack_DeltaStateWriter.c
+// Columnar state block with quantized per-entity deltas
+// Positions are sent in centimeters and rotation in tenths of a degree. Each entity starts with a
+// keyframe (absolute quantized values) and repeats one every KEYFRAME_INTERVAL samples; the samples
+// in between only carry the difference to the previous sample of the same entity.
+// Deltas are taken between quantized values, so the error never accumulates: the API reconstructs
+// every sample to within half a quantization step.
+// Batch contract: the API decodes each entity's chain in batchSeq order, not arrival order (several
+// batches are in flight, failed ones are resent later). A delta whose base batch never arrives is
+// skipped until the entity's next keyframe - lost batches are followed by ForceKeyframes().
+//
+//   "stateDeltas":{
+//     "posScale":100, "rotScale":10,
+//     "entityIds":[...], "entity":[...], "timestamp":[...],
+//     "key":[1,0,...],                  - 1 = absolute keyframe, 0 = delta
+//     "x":[...], "y":[...], "z":[...], "r":[...],
+//     "isAlive":[1,0,...]
+//   }
+
+class OpsTrack_DeltaStateWriter : OpsTrack_ColumnarStateWriter
+{
+	protected ref map<string, ref OpsTrack_DeltaTrack> m_Tracks;
+	protected ref array<OpsTrack_DeltaTrack> m_Touched;   // Tracks with pending values from the last Write()
+
+	// Columns of the batch being built
+	protected ref array<int> m_Key;
+	protected ref array<int> m_X;
+	protected ref array<int> m_Y;
+	protected ref array<int> m_Z;
+	protected ref array<int> m_R;
+
+	// Mission statistics (committed batches only)
+	protected int m_Samples;
+	protected int m_Keyframes;
+	protected int m_AbsoluteBytes;   // Size of the four float columns in the columnar encoding
+	protected int m_DeltaBytes;      // Size of the same values as quantized deltas (incl. key flag)
+	protected float m_MaxPosError;   // Meters
+	protected float m_MaxRotError;   // Degrees
+
+	// Statistics of the batch being built
+	protected int m_PendingSamples;
+	protected int m_PendingKeyframes;
+	protected int m_PendingAbsoluteBytes;
+	protected int m_PendingDeltaBytes;
+	protected float m_PendingMaxPosError;
+	protected float m_PendingMaxRotError;
+
+	static const int POS_SCALE = 100;            // Centimeters
+	static const int ROT_SCALE = 10;             // Tenths of a degree
+	private static const int KEYFRAME_INTERVAL = 30; // Samples between keyframes (~30 s at 1 Hz)
+	private static const int FULL_TURN = 3600;       // 360 degrees in rotation units
+
+	void OpsTrack_DeltaStateWriter()
+	{
+		m_Tracks = new map<string, ref OpsTrack_DeltaTrack>();
+		m_Touched = new array<OpsTrack_DeltaTrack>();
+		m_Key = new array<int>();
+		m_X = new array<int>();
+		m_Y = new array<int>();
+		m_Z = new array<int>();
+		m_R = new array<int>();
+		ResetMission();
+	}
+
+	// Write the oldest count states as "stateDeltas":{...}
+	// Track updates stay pending until Commit(), so a batch can be rebuilt (smaller) without breaking the chain
+	override void Write(OpsTrack_PayloadWriter writer, OpsTrack_StateQueue states, int count)
+	{
+		if (!states)
+			count = 0;
+		else if (count > states.Count())
+			count = states.Count();
+
+		BuildEntityTable(states, count);
+		EncodeSamples(states, count);
+
+		writer.Append("\"stateDeltas\":{\"posScale\":");
+		writer.Append(POS_SCALE.ToString());
+		writer.Append(",\"rotScale\":");
+		writer.Append(ROT_SCALE.ToString());
+
+		writer.Append(",\"entityIds\":[");
+		for (int e = 0; e < m_EntityIds.Count(); e++)
+		{
+			if (e > 0)
+				writer.Append(",");
+			writer.AppendQuoted(m_EntityIds[e]);
+		}
+		writer.Append("]");
+
+		WriteIntColumn(writer, "entity", m_SampleEntity);
+
+		writer.Append(",\"timestamp\":[");
+		for (int t = 0; t < count; t++)
+		{
+			if (t > 0)
+				writer.Append(",");
+			writer.Append(states.Get(t).timestamp.ToString());
+		}
+		writer.Append("]");
+
+		WriteIntColumn(writer, "key", m_Key);
+		WriteIntColumn(writer, "x", m_X);
+		WriteIntColumn(writer, "y", m_Y);
+		WriteIntColumn(writer, "z", m_Z);
+		WriteIntColumn(writer, "r", m_R);
+
+		writer.Append(",\"isAlive\":[");
+		for (int a = 0; a < count; a++)
+		{
+			if (a > 0)
+				writer.Append(",");
+			if (states.Get(a).isAlive)
+				writer.Append("1");
+			else
+				writer.Append("0");
+		}
+		writer.Append("]}");
+	}
+
+	// The last written batch is final - make its values the base for the next one
+	void Commit()
+	{
+		foreach (OpsTrack_DeltaTrack track : m_Touched)
+		{
+			track.Commit();
+		}
+		m_Touched.Clear();
+
+		m_Samples += m_PendingSamples;
+		m_Keyframes += m_PendingKeyframes;
+		m_AbsoluteBytes += m_PendingAbsoluteBytes;
+		m_DeltaBytes += m_PendingDeltaBytes;
+		if (m_PendingMaxPosError > m_MaxPosError)
+			m_MaxPosError = m_PendingMaxPosError;
+		if (m_PendingMaxRotError > m_MaxRotError)
+			m_MaxRotError = m_PendingMaxRotError;
+
+		ResetPendingStats();
+	}
+
+	// The last written batch was not used - the next one starts from the committed values again
+	void Discard()
+	{
+		foreach (OpsTrack_DeltaTrack track : m_Touched)
+		{
+			track.touched = false;
+		}
+		m_Touched.Clear();
+		ResetPendingStats();
+	}
+
+	// A batch was lost (rejected or dropped) - the next sample of every entity is a keyframe
+	void ForceKeyframes()
+	{
+		m_Tracks.Clear();
+		m_Touched.Clear();
+	}
+
+	// New mission: forget all tracks and statistics
+	void ResetMission()
+	{
+		ForceKeyframes();
+		m_Samples = 0;
+		m_Keyframes = 0;
+		m_AbsoluteBytes = 0;
+		m_DeltaBytes = 0;
+		m_MaxPosError = 0;
+		m_MaxRotError = 0;
+		ResetPendingStats();
+	}
+
+	bool HasStats()
+	{
+		return m_Samples > 0;
+	}
+
+	// One-line mission summary: savings against the float columns and worst reconstruction error
+	string GetReport()
+	{
+		int savedPercent = 0;
+		if (m_AbsoluteBytes > 0)
+		{
+			float ratio = m_DeltaBytes;
+			ratio = ratio / m_AbsoluteBytes;
+			savedPercent = Math.Round((1 - ratio) * 100);
+		}
+
+		return string.Format(
+			"Delta states: %1 samples, %2 keyframes, %3 -> %4 bytes (%5% saved), max error %6 m / %7 deg",
+			m_Samples, m_Keyframes, m_AbsoluteBytes, m_DeltaBytes, savedPercent, m_MaxPosError, m_MaxRotError
+		);
+	}
+
+	// Fill the key/x/y/z/r columns from the committed tracks
+	protected void EncodeSamples(OpsTrack_StateQueue states, int count)
+	{
+		// A rebuild starts over from the committed values
+		Discard();
+
+		m_Key.Clear();
+		m_X.Clear();
+		m_Y.Clear();
+		m_Z.Clear();
+		m_R.Clear();
+
+		for (int i = 0; i < count; i++)
+		{
+			OpsTrack_EntityState state = states.Get(i);
+			OpsTrack_DeltaTrack track = GetTrack(m_EntityIds[m_SampleEntity[i]]);
+			if (!track.touched)
+			{
+				track.BeginBatch();
+				m_Touched.Insert(track);
+			}
+
+			int qx = Math.Round(state.posX * POS_SCALE);
+			int qy = Math.Round(state.posY * POS_SCALE);
+			int qz = Math.Round(state.posZ * POS_SCALE);
+			int qr = Math.Round(state.rotation * ROT_SCALE);
+			qr = WrapRotation(qr);
+
+			bool isKey = !track.pendingHasBase || track.pendingSamplesSinceKey >= KEYFRAME_INTERVAL;
+			if (isKey)
+			{
+				m_Key.Insert(1);
+				m_X.Insert(qx);
+				m_Y.Insert(qy);
+				m_Z.Insert(qz);
+				m_R.Insert(qr);
+				track.pendingSamplesSinceKey = 0;
+				track.pendingHasBase = true;
+				m_PendingKeyframes++;
+			}
+			else
+			{
+				m_Key.Insert(0);
+				m_X.Insert(qx - track.pendingX);
+				m_Y.Insert(qy - track.pendingY);
+				m_Z.Insert(qz - track.pendingZ);
+				m_R.Insert(WrapRotation(qr - track.pendingR));
+			}
+
+			track.pendingX = qx;
+			track.pendingY = qy;
+			track.pendingZ = qz;
+			track.pendingR = qr;
+			track.pendingSamplesSinceKey++;
+
+			RecordSample(state, qx, qy, qz, qr, i);
+		}
+	}
+
+	// Size and error bookkeeping for one sample
+	protected void RecordSample(OpsTrack_EntityState state, int qx, int qy, int qz, int qr, int column)
+	{
+		m_PendingSamples++;
+
+		m_PendingAbsoluteBytes += state.posX.ToString().Length() + state.posY.ToString().Length()
+			+ state.posZ.ToString().Length() + state.rotation.ToString().Length() + 4;
+		m_PendingDeltaBytes += m_X[column].ToString().Length() + m_Y[column].ToString().Length()
+			+ m_Z[column].ToString().Length() + m_R[column].ToString().Length() + 6;
+
+		float posError = Math.AbsFloat(state.posX - Dequantize(qx, POS_SCALE));
+		posError = Math.Max(posError, Math.AbsFloat(state.posY - Dequantize(qy, POS_SCALE)));
+		posError = Math.Max(posError, Math.AbsFloat(state.posZ - Dequantize(qz, POS_SCALE)));
+		if (posError > m_PendingMaxPosError)
+			m_PendingMaxPosError = posError;
+
+		// Compare on the circle so -180 and 180 count as equal
+		float rotError = Math.AbsFloat(state.rotation - Dequantize(qr, ROT_SCALE));
+		if (rotError > 180)
+			rotError = 360 - rotError;
+		if (rotError > m_PendingMaxRotError)
+			m_PendingMaxRotError = rotError;
+	}
+
+	protected OpsTrack_DeltaTrack GetTrack(string entityId)
+	{
+		OpsTrack_DeltaTrack track = m_Tracks.Get(entityId);
+		if (!track)
+		{
+			track = new OpsTrack_DeltaTrack();
+			m_Tracks.Insert(entityId, track);
+		}
+		return track;
+	}
+
+	protected static float Dequantize(int value, int scale)
+	{
+		float result = value;
+		return result / scale;
+	}
+
+	// Keep rotation values and deltas in (-180, 180] degrees
+	protected static int WrapRotation(int value)
+	{
+		while (value > FULL_TURN / 2)
+			value -= FULL_TURN;
+		while (value <= -FULL_TURN / 2)
+			value += FULL_TURN;
+		return value;
+	}
+
+	protected void WriteIntColumn(OpsTrack_PayloadWriter writer, string key, array<int> values)
+	{
+		writer.Append(",\"" + key + "\":[");
+		for (int i = 0; i < values.Count(); i++)
+		{
+			if (i > 0)
+				writer.Append(",");
+			writer.Append(values[i].ToString());
+		}
+		writer.Append("]");
+	}
+
+	protected void ResetPendingStats()
+	{
+		m_PendingSamples = 0;
+		m_PendingKeyframes = 0;
+		m_PendingAbsoluteBytes = 0;
+		m_PendingDeltaBytes = 0;
+		m_PendingMaxPosError = 0;
+		m_PendingMaxRotError = 0;
+	}
+}
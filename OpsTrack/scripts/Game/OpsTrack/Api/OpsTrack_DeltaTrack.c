@@ -0,0 +1,54 @@
+// OpsTrack_DeltaTrack.c
+// Last quantized position/rotation sent for one entity (used by OpsTrack_DeltaStateWriter)
+// "Committed" values are what the API has been sent; "pending" values belong to the batch being built
+// and only become committed once that batch is final.
+
+class OpsTrack_DeltaTrack
+{
+	// Committed (last value in a finished batch)
+	int x;
+	int y;
+	int z;
+	int r;
+	int samplesSinceKey;
+	bool hasBase;
+
+	// Pending (batch currently being built)
+	int pendingX;
+	int pendingY;
+	int pendingZ;
+	int pendingR;
+	int pendingSamplesSinceKey;
+	bool pendingHasBase;
+	bool touched;
+
+	void OpsTrack_DeltaTrack()
+	{
+		hasBase = false;
+		samplesSinceKey = 0;
+		touched = false;
+	}
+
+	// Start a (re)build from the committed values
+	void BeginBatch()
+	{
+		pendingX = x;
+		pendingY = y;
+		pendingZ = z;
+		pendingR = r;
+		pendingSamplesSinceKey = samplesSinceKey;
+		pendingHasBase = hasBase;
+		touched = true;
+	}
+
+	void Commit()
+	{
+		x = pendingX;
+		y = pendingY;
+		z = pendingZ;
+		r = pendingR;
+		samplesSinceKey = pendingSamplesSinceKey;
+		hasBase = pendingHasBase;
+		touched = false;
+	}
+}
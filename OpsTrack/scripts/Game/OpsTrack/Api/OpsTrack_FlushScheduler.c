@@ -0,0 +1,202 @@
+// OpsTrack_FlushScheduler.c
+// Adaptive flush interval and batch size for ApiClient
+// Batch size follows AIMD on response latency: fast responses grow it step by step,
+// slow responses or failures halve it. The flush interval shrinks as the state queue fills
+// and stretches out on a quiet server.
+
+class OpsTrack_FlushScheduler
+{
+	protected bool m_Adaptive;
+	protected int m_DefaultIntervalMs;
+	protected int m_DefaultBatchSize;
+
+	// Current decisions
+	protected int m_IntervalMs;
+	protected int m_BatchSize;
+
+	// Measurements (exponentially weighted moving averages)
+	protected float m_AvgRttMs;
+	protected float m_AvgBytesPerState;
+	protected int m_LastQueueDepth;
+
+	// Reporting
+	protected int m_LastReportTick;
+	protected int m_ReportedIntervalMs;
+	protected int m_ReportedBatchSize;
+
+	private static const int MIN_INTERVAL_MS = 500;
+	private static const int MAX_INTERVAL_MS = 10000;
+	private static const int MIN_BATCH_SIZE = 100;
+	private static const int MAX_BATCH_SIZE = 2000;
+	private static const int BATCH_STEP = 50;           // Additive increase per fast response
+	private static const int TARGET_RTT_MS = 1000;      // Responses faster than this grow the batch
+	private static const int SLOW_RTT_MS = 3000;        // Responses slower than this halve the batch
+	private static const float EWMA_WEIGHT = 0.2;
+	private static const int PAYLOAD_BUDGET_BYTES = 400000; // Half of ApiClient's 800KB hard limit
+	private static const int REPORT_INTERVAL_MS = 30000;    // Info-level decision log at most this often
+
+	void OpsTrack_FlushScheduler(int defaultIntervalMs, int defaultBatchSize)
+	{
+		m_DefaultIntervalMs = defaultIntervalMs;
+		m_DefaultBatchSize = defaultBatchSize;
+		m_IntervalMs = defaultIntervalMs;
+		m_BatchSize = defaultBatchSize;
+		m_AvgRttMs = 0;
+		m_AvgBytesPerState = 0;
+		m_LastQueueDepth = 0;
+		m_LastReportTick = 0;
+		m_ReportedIntervalMs = defaultIntervalMs;
+		m_ReportedBatchSize = defaultBatchSize;
+		m_Adaptive = true;
+	}
+
+	// Fixed mode uses the defaults ApiClient was built with
+	void SetAdaptive(bool adaptive)
+	{
+		m_Adaptive = adaptive;
+		if (!m_Adaptive)
+		{
+			m_IntervalMs = m_DefaultIntervalMs;
+			m_BatchSize = m_DefaultBatchSize;
+		}
+	}
+
+	bool IsAdaptive()
+	{
+		return m_Adaptive;
+	}
+
+	int GetIntervalMs()
+	{
+		return m_IntervalMs;
+	}
+
+	int GetBatchSize()
+	{
+		return m_BatchSize;
+	}
+
+	float GetAverageRttMs()
+	{
+		return m_AvgRttMs;
+	}
+
+	// Called on every flush check with the current state queue depth
+	void Update(int queueDepth)
+	{
+		m_LastQueueDepth = queueDepth;
+		if (!m_Adaptive)
+			return;
+
+		// Full batch waiting -> flush as fast as allowed, empty queue -> stretch to the max
+		float fill = queueDepth;
+		fill = fill / m_BatchSize;
+		if (fill > 1)
+			fill = 1;
+
+		int interval = MAX_INTERVAL_MS - Math.Round((MAX_INTERVAL_MS - MIN_INTERVAL_MS) * fill);
+
+		// No point in flushing much faster than the API answers
+		int rttFloor = Math.Round(m_AvgRttMs * 0.5);
+		if (interval < rttFloor)
+			interval = rttFloor;
+
+		m_IntervalMs = Math.ClampInt(interval, MIN_INTERVAL_MS, MAX_INTERVAL_MS);
+		Report();
+	}
+
+	// Called when a batch is posted
+	void OnBatchSent(int stateCount, int payloadBytes)
+	{
+		if (stateCount <= 0)
+			return;
+
+		float bytesPerState = payloadBytes;
+		bytesPerState = bytesPerState / stateCount;
+		if (m_AvgBytesPerState <= 0)
+			m_AvgBytesPerState = bytesPerState;
+		else
+			m_AvgBytesPerState += (bytesPerState - m_AvgBytesPerState) * EWMA_WEIGHT;
+
+		ClampBatchSize();
+	}
+
+	// Called when a batch response arrives
+	void OnBatchAcked(int rttMs)
+	{
+		if (m_AvgRttMs <= 0)
+			m_AvgRttMs = rttMs;
+		else
+			m_AvgRttMs += (rttMs - m_AvgRttMs) * EWMA_WEIGHT;
+
+		if (!m_Adaptive)
+			return;
+
+		if (rttMs > SLOW_RTT_MS)
+			m_BatchSize = m_BatchSize / 2;
+		else if (rttMs < TARGET_RTT_MS)
+			m_BatchSize += BATCH_STEP;
+
+		ClampBatchSize();
+		Report();
+	}
+
+	// Called when a batch fails (timeout or server error)
+	void OnBatchFailed()
+	{
+		if (!m_Adaptive)
+			return;
+
+		m_BatchSize = m_BatchSize / 2;
+		ClampBatchSize();
+		Report();
+	}
+
+	// Keep the batch inside the state limits and the byte budget
+	protected void ClampBatchSize()
+	{
+		if (!m_Adaptive)
+			return;
+
+		int maxSize = MAX_BATCH_SIZE;
+		if (m_AvgBytesPerState > 0)
+		{
+			int budgetSize = Math.Floor(PAYLOAD_BUDGET_BYTES / m_AvgBytesPerState);
+			if (budgetSize < maxSize)
+				maxSize = budgetSize;
+		}
+
+		if (maxSize < MIN_BATCH_SIZE)
+			maxSize = MIN_BATCH_SIZE;
+
+		m_BatchSize = Math.ClampInt(m_BatchSize, MIN_BATCH_SIZE, maxSize);
+	}
+
+	// Log decisions: every change at debug level, a summary at info level at most every 30s
+	protected void Report()
+	{
+		if (m_IntervalMs == m_ReportedIntervalMs && m_BatchSize == m_ReportedBatchSize)
+			return;
+
+		int avgRtt = Math.Round(m_AvgRttMs);
+		int avgBytes = Math.Round(m_AvgBytesPerState);
+		string line = string.Format(
+			"Flush scheduler: interval %1 ms, batch %2 states (avg RTT %3 ms, %4 bytes/state, queue %5)",
+			m_IntervalMs, m_BatchSize, avgRtt, avgBytes, m_LastQueueDepth
+		);
+
+		int now = System.GetTickCount();
+		if (now - m_LastReportTick >= REPORT_INTERVAL_MS)
+		{
+			OpsTrackLogger.Info(line);
+			m_LastReportTick = now;
+		}
+		else
+		{
+			OpsTrackLogger.Debug(line);
+		}
+
+		m_ReportedIntervalMs = m_IntervalMs;
+		m_ReportedBatchSize = m_BatchSize;
+	}
+}
@@ -0,0 +1,309 @@
+// OpsTrack_Journal.c
+// Append-only write-ahead journal for /batch payloads
+// Batches that can't be sent (API backoff, server shutdown) are spilled to segment files
+// under $profile: and replayed in order once the API is reachable again.
+//
+// Layout:
+//   $profile:OpsTrackJournal/segment_<n>.jsonl  - one batch payload per line
+//   $profile:OpsTrackJournal/journal.idx        - "<firstSegment> <nextSegment> <ackedLines>"
+//
+// Segments are deleted (compacted) as soon as every batch in them has been acknowledged.
+
+class OpsTrack_Journal
+{
+	private static const string JOURNAL_DIR = "$profile:OpsTrackJournal";
+	private static const string INDEX_PATH = "$profile:OpsTrackJournal/journal.idx";
+	private static const int SEGMENT_MAX_BYTES = 4194304; // 4MB - roll to a new segment after this
+
+	protected int m_FirstSegment;   // Oldest segment that still has unacknowledged batches
+	protected int m_NextSegment;    // Segment id to use for the next roll
+	protected int m_WriteSegment;   // Segment currently appended to (-1 = none open)
+	protected int m_WriteBytes;     // Bytes appended to the write segment
+	protected int m_AckedLines;     // Acknowledged batches in the first segment
+	protected int m_MaxSegments;    // Disk bound: segments kept before the oldest is dropped
+	protected bool m_SegmentDropped; // A segment was dropped since the last TakeSegmentDrop()
+
+	// Batches of the segment currently being replayed
+	protected ref array<string> m_ReadBatches;
+	protected int m_ReadSegment;
+
+	// Diagnostics
+	protected int m_SpilledBatches;
+	protected int m_ReplayedBatches;
+	protected int m_DroppedSegments;
+
+	void OpsTrack_Journal(int maxBytes)
+	{
+		m_ReadBatches = new array<string>();
+		m_ReadSegment = -1;
+		m_WriteSegment = -1;
+		m_WriteBytes = 0;
+		m_SegmentDropped = false;
+		SetMaxBytes(maxBytes);
+
+		FileIO.MakeDirectory(JOURNAL_DIR);
+		LoadIndex();
+
+		if (HasPending())
+		{
+			OpsTrackLogger.Info(string.Format("Journal: found %1 segment(s) from previous session, %2 batch(es) already acknowledged",
+				m_NextSegment - m_FirstSegment, m_AckedLines));
+		}
+	}
+
+	void SetMaxBytes(int maxBytes)
+	{
+		m_MaxSegments = maxBytes / SEGMENT_MAX_BYTES;
+		if (m_MaxSegments < 2)
+			m_MaxSegments = 2;
+	}
+
+	// ============================================
+	// WRITE SIDE
+	// ============================================
+
+	// Append one batch payload. Returns false if the write failed.
+	bool Append(string payload)
+	{
+		if (!payload || payload == "")
+			return false;
+
+		if (StartsNewSegment())
+			RollSegment();
+
+		FileHandle fh = FileIO.OpenFile(GetSegmentPath(m_WriteSegment), FileMode.APPEND);
+		if (!fh)
+			fh = FileIO.OpenFile(GetSegmentPath(m_WriteSegment), FileMode.WRITE);
+
+		if (!fh)
+		{
+			OpsTrackLogger.Error(string.Format("Journal: could not open segment %1 for writing", m_WriteSegment));
+			return false;
+		}
+
+		fh.WriteLine(payload);
+		fh.Close();
+
+		m_WriteBytes += payload.Length() + 1;
+		m_SpilledBatches++;
+		return true;
+	}
+
+	// The next Append() opens a new segment
+	bool StartsNewSegment()
+	{
+		return m_WriteSegment < 0 || m_WriteBytes >= SEGMENT_MAX_BYTES;
+	}
+
+	// Start a new segment and enforce the disk bound
+	protected void RollSegment()
+	{
+		m_WriteSegment = m_NextSegment;
+		m_NextSegment++;
+		m_WriteBytes = 0;
+
+		// Drop the oldest segments if we're over budget (data loss, but bounded disk usage)
+		while (m_NextSegment - m_FirstSegment > m_MaxSegments)
+		{
+			OpsTrackLogger.Warn(string.Format("Journal: disk budget exceeded, dropping oldest segment %1", m_FirstSegment));
+			DeleteSegment(m_FirstSegment);
+			m_DroppedSegments++;
+			m_SegmentDropped = true;
+		}
+
+		SaveIndex();
+	}
+
+	// Whether batches were lost to the disk budget since the last call (the base of delta chains is gone)
+	bool TakeSegmentDrop()
+	{
+		bool dropped = m_SegmentDropped;
+		m_SegmentDropped = false;
+		return dropped;
+	}
+
+	// ============================================
+	// REPLAY SIDE
+	// ============================================
+
+	bool HasPending()
+	{
+		if (m_FirstSegment < m_NextSegment)
+			return true;
+		return false;
+	}
+
+	// Next unacknowledged batch in journal order ("" if none)
+	string PeekBatch()
+	{
+		while (HasPending())
+		{
+			if (!EnsureReadSegment())
+				continue;
+
+			if (m_AckedLines < m_ReadBatches.Count())
+				return m_ReadBatches[m_AckedLines];
+
+			// Segment fully acknowledged (or empty) - compact and move on
+			DeleteSegment(m_FirstSegment);
+		}
+
+		return "";
+	}
+
+	// Mark the batch returned by PeekBatch() as delivered
+	void AckBatch()
+	{
+		if (!HasPending() || m_ReadSegment != m_FirstSegment)
+			return;
+
+		m_AckedLines++;
+		m_ReplayedBatches++;
+
+		if (m_AckedLines >= m_ReadBatches.Count())
+		{
+			OpsTrackLogger.Info(string.Format("Journal: segment %1 acknowledged (%2 batches), compacting", m_FirstSegment, m_ReadBatches.Count()));
+			DeleteSegment(m_FirstSegment);
+		}
+		else
+		{
+			SaveIndex();
+		}
+	}
+
+	// Load the first segment into memory. Returns false if it had to be skipped.
+	protected bool EnsureReadSegment()
+	{
+		if (m_ReadSegment == m_FirstSegment)
+			return true;
+
+		// Never read the segment we're still appending to - seal it first
+		if (m_FirstSegment == m_WriteSegment)
+		{
+			m_WriteSegment = -1;
+			m_WriteBytes = 0;
+		}
+
+		m_ReadBatches.Clear();
+		m_ReadSegment = m_FirstSegment;
+
+		string path = GetSegmentPath(m_FirstSegment);
+		FileHandle fh = FileIO.OpenFile(path, FileMode.READ);
+		if (!fh)
+		{
+			OpsTrackLogger.Warn(string.Format("Journal: segment %1 missing, skipping", m_FirstSegment));
+			DeleteSegment(m_FirstSegment);
+			return false;
+		}
+
+		string line;
+		while (fh.ReadLine(line) > 0)
+		{
+			m_ReadBatches.Insert(line);
+		}
+		fh.Close();
+
+		OpsTrackLogger.Debug(string.Format("Journal: loaded segment %1 (%2 batches)", m_FirstSegment, m_ReadBatches.Count()));
+		return true;
+	}
+
+	// Remove the first segment and advance the index (compaction)
+	protected void DeleteSegment(int segment)
+	{
+		FileIO.DeleteFile(GetSegmentPath(segment));
+
+		if (segment == m_FirstSegment)
+		{
+			m_FirstSegment++;
+			m_AckedLines = 0;
+		}
+
+		if (segment == m_ReadSegment)
+		{
+			m_ReadSegment = -1;
+			m_ReadBatches.Clear();
+		}
+
+		if (segment == m_WriteSegment)
+		{
+			m_WriteSegment = -1;
+			m_WriteBytes = 0;
+		}
+
+		SaveIndex();
+	}
+
+	// ============================================
+	// INDEX
+	// ============================================
+
+	protected void LoadIndex()
+	{
+		m_FirstSegment = 0;
+		m_NextSegment = 0;
+		m_AckedLines = 0;
+
+		FileHandle fh = FileIO.OpenFile(INDEX_PATH, FileMode.READ);
+		if (!fh)
+			return;
+
+		string line;
+		fh.ReadLine(line);
+		fh.Close();
+
+		array<string> parts = {};
+		line.Split(" ", parts, true);
+		if (parts.Count() < 3)
+		{
+			OpsTrackLogger.Warn("Journal: index file is corrupt, starting empty");
+			return;
+		}
+
+		m_FirstSegment = parts[0].ToInt();
+		m_NextSegment = parts[1].ToInt();
+		m_AckedLines = parts[2].ToInt();
+
+		if (m_NextSegment < m_FirstSegment)
+			m_NextSegment = m_FirstSegment;
+	}
+
+	protected void SaveIndex()
+	{
+		FileHandle fh = FileIO.OpenFile(INDEX_PATH, FileMode.WRITE);
+		if (!fh)
+		{
+			OpsTrackLogger.Error("Journal: could not write index file");
+			return;
+		}
+
+		fh.WriteLine(string.Format("%1 %2 %3", m_FirstSegment, m_NextSegment, m_AckedLines));
+		fh.Close();
+	}
+
+	protected string GetSegmentPath(int segment)
+	{
+		return string.Format("%1/segment_%2.jsonl", JOURNAL_DIR, segment);
+	}
+
+	// --- Diagnostics ---
+
+	int GetPendingSegments()
+	{
+		return m_NextSegment - m_FirstSegment;
+	}
+
+	int GetSpilledBatches()
+	{
+		return m_SpilledBatches;
+	}
+
+	int GetReplayedBatches()
+	{
+		return m_ReplayedBatches;
+	}
+
+	int GetDroppedSegments()
+	{
+		return m_DroppedSegments;
+	}
+}
@@ -0,0 +1,26 @@
+// OpsTrack_PayloadRecord.c
+// Base class for queued batch items (events, entities, crew and group states)
+// Records stay structured in the queues and are written into the batch when it is built.
+
+class OpsTrack_PayloadRecord
+{
+	// Write the record as one JSON object. strings: the ApiClient's string table, null to write strings inline
+	void Write(OpsTrack_JsonWriter json, OpsTrack_StringTable strings)
+	{
+		json.BeginObject();
+		json.EndObject();
+	}
+
+	// The record on its own (logging) - batches use Write
+	string AsPayload(OpsTrack_StringTable strings = null)
+	{
+		OpsTrack_JsonWriter json = new OpsTrack_JsonWriter();
+		Write(json, strings);
+		return json.Finish();
+	}
+
+	// Called when the queue drops the record (sent or overflowed) - pooled types return to their pool
+	void Recycle()
+	{
+	}
+}
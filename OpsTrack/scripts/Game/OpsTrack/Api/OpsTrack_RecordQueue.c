@@ -0,0 +1,115 @@
+// OpsTrack_RecordQueue.c
+// Fixed-capacity ring buffer for queued batch records (events, entities, crew and group states)
+// Same layout as OpsTrack_StateQueue: slots are allocated once, draining k records is O(k)
+// Records are serialized by the batch builder, so nothing is formatted for data that gets dropped
+
+class OpsTrack_RecordQueue
+{
+	protected ref array<ref OpsTrack_PayloadRecord> m_Items;
+	protected int m_Head;      // Index of the oldest record
+	protected int m_Count;
+	protected int m_Capacity;
+
+	// Diagnostics
+	protected int m_HighWaterMark;  // Deepest the queue has been since last reset
+	protected int m_OverflowCount;  // Records dropped because the queue was full
+
+	void OpsTrack_RecordQueue(int capacity)
+	{
+		if (capacity < 1)
+			capacity = 1;
+
+		m_Items = new array<ref OpsTrack_PayloadRecord>();
+		m_Items.Resize(capacity);
+		m_Capacity = capacity;
+		m_Head = 0;
+		m_Count = 0;
+		m_HighWaterMark = 0;
+		m_OverflowCount = 0;
+	}
+
+	// Add a record at the tail. When full, the oldest record is overwritten.
+	// Returns false if a record had to be dropped to make room.
+	bool Push(OpsTrack_PayloadRecord record)
+	{
+		if (m_Count == m_Capacity)
+		{
+			m_Items[m_Head].Recycle();
+			m_Items[m_Head] = record;
+			m_Head = (m_Head + 1) % m_Capacity;
+			m_OverflowCount++;
+			return false;
+		}
+
+		m_Items[(m_Head + m_Count) % m_Capacity] = record;
+		m_Count++;
+
+		if (m_Count > m_HighWaterMark)
+			m_HighWaterMark = m_Count;
+
+		return true;
+	}
+
+	// Get the record at position index counted from the oldest (0 = oldest)
+	OpsTrack_PayloadRecord Get(int index)
+	{
+		if (index < 0 || index >= m_Count)
+			return null;
+
+		return m_Items[(m_Head + index) % m_Capacity];
+	}
+
+	// Remove the oldest count records
+	void Drop(int count)
+	{
+		if (count > m_Count)
+			count = m_Count;
+
+		for (int i = 0; i < count; i++)
+		{
+			m_Items[m_Head].Recycle();
+			m_Items[m_Head] = null;
+			m_Head = (m_Head + 1) % m_Capacity;
+		}
+
+		m_Count -= count;
+		if (m_Count == 0)
+			m_Head = 0;
+	}
+
+	void Clear()
+	{
+		Drop(m_Count);
+	}
+
+	int Count()
+	{
+		return m_Count;
+	}
+
+	bool IsEmpty()
+	{
+		return m_Count == 0;
+	}
+
+	int GetCapacity()
+	{
+		return m_Capacity;
+	}
+
+	int GetHighWaterMark()
+	{
+		return m_HighWaterMark;
+	}
+
+	int GetOverflowCount()
+	{
+		return m_OverflowCount;
+	}
+
+	void ResetStats()
+	{
+		m_HighWaterMark = m_Count;
+		m_OverflowCount = 0;
+	}
+}
@@ -0,0 +1,11 @@
+// OpsTrack_RequestKind.c
+
+enum OpsTrack_RequestKind
+{
+	MISSION,        // Mission start/end
+	BATCH,          // Live /batch upload
+	JOURNAL_BATCH,  // /batch replayed from the journal
+	PROBE,          // Half-open circuit breaker health check
+	EVENT_BATCH,    // /batch carrying only combat/connection events (event lane)
+	CAPABILITIES    // GET /capabilities - which state encodings the API accepts
+}
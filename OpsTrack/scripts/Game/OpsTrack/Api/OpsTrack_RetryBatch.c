@@ -0,0 +1,26 @@
+// OpsTrack_RetryBatch.c
+// A batch that failed to send and waits for another attempt (kept in ApiClient's retry table)
+// The payload is resent unchanged apart from its string block (see ApiClient.CopyFailedBatch) -
+// its batchId lets the API drop it if an earlier attempt did arrive.
+
+class OpsTrack_RetryBatch
+{
+	string payload;
+	int batchSeq;
+	OpsTrack_RequestKind kind;
+	int attempts;       // Attempts made so far
+	int dueTick;        // Not resent before this tick
+	int stringCount;    // The payload carries string table entries [0, stringCount) (0 = none)
+	int stringGeneration;
+
+	void OpsTrack_RetryBatch(OpsTrackCallback failed, int delayMs)
+	{
+		payload = failed.GetPayload();
+		batchSeq = failed.GetBatchSeq();
+		kind = failed.GetKind();
+		attempts = failed.GetAttempt();
+		dueTick = System.GetTickCount() + delayMs;
+		stringCount = 0;
+		stringGeneration = 0;
+	}
+}
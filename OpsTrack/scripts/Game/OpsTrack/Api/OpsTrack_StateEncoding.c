@@ -0,0 +1,8 @@
+// OpsTrack_StateEncoding.c
+
+enum OpsTrack_StateEncoding
+{
+	ROW,        // "states":[{...}, ...] - one object per sample
+	COLUMNAR,   // "stateColumns":{...} - parallel arrays per field plus an entity table
+	DELTA       // "stateDeltas":{...} - columnar, positions/rotation as quantized per-entity deltas
+}
@@ -0,0 +1,145 @@
+// OpsTrack_StateQueue.c
+// Fixed-capacity ring buffer for queued entity states
+// Draining k states is O(k) - nothing is shifted, the head index just moves forward
+// States are kept structured and serialized when a batch is built, so the batch can pick the encoding
+// Dropped states (sent or overflowed) go back to OpsTrack_StatePool
+
+class OpsTrack_StateQueue
+{
+	protected ref array<ref OpsTrack_EntityState> m_Items;
+	protected int m_Head;      // Index of the oldest state
+	protected int m_Count;
+	protected int m_Capacity;
+
+	// Diagnostics
+	protected int m_HighWaterMark;  // Deepest the queue has been since last reset
+	protected int m_OverflowCount;  // States dropped because the queue was full
+
+	void OpsTrack_StateQueue(int capacity)
+	{
+		m_Items = new array<ref OpsTrack_EntityState>();
+		m_Head = 0;
+		m_Count = 0;
+		m_HighWaterMark = 0;
+		m_OverflowCount = 0;
+		SetCapacity(capacity);
+	}
+
+	// Add a state at the tail. When full, the oldest state is overwritten.
+	// Returns false if a state had to be dropped to make room.
+	bool Push(OpsTrack_EntityState state)
+	{
+		if (m_Count == m_Capacity)
+		{
+			OpsTrack_StatePool.Get().Release(m_Items[m_Head]);
+			m_Items[m_Head] = state;
+			m_Head = (m_Head + 1) % m_Capacity;
+			m_OverflowCount++;
+			return false;
+		}
+
+		m_Items[(m_Head + m_Count) % m_Capacity] = state;
+		m_Count++;
+
+		if (m_Count > m_HighWaterMark)
+			m_HighWaterMark = m_Count;
+
+		return true;
+	}
+
+	// Get the state at position index counted from the oldest (0 = oldest)
+	OpsTrack_EntityState Get(int index)
+	{
+		if (index < 0 || index >= m_Count)
+			return null;
+
+		return m_Items[(m_Head + index) % m_Capacity];
+	}
+
+	// Remove the oldest count states
+	void Drop(int count)
+	{
+		if (count > m_Count)
+			count = m_Count;
+
+		for (int i = 0; i < count; i++)
+		{
+			// Return the state to the pool so the next capture reuses it
+			OpsTrack_StatePool.Get().Release(m_Items[m_Head]);
+			m_Items[m_Head] = null;
+			m_Head = (m_Head + 1) % m_Capacity;
+		}
+
+		m_Count -= count;
+		if (m_Count == 0)
+			m_Head = 0;
+	}
+
+	void Clear()
+	{
+		Drop(m_Count);
+	}
+
+	// Change capacity, keeping the newest states if the queue no longer fits
+	void SetCapacity(int capacity)
+	{
+		if (capacity < 1)
+			capacity = 1;
+
+		if (capacity == m_Capacity)
+			return;
+
+		array<ref OpsTrack_EntityState> items = new array<ref OpsTrack_EntityState>();
+		items.Resize(capacity);
+
+		int keep = m_Count;
+		if (keep > capacity)
+		{
+			m_OverflowCount += keep - capacity;
+			keep = capacity;
+		}
+
+		int skip = m_Count - keep;
+		for (int i = 0; i < keep; i++)
+		{
+			items[i] = m_Items[(m_Head + skip + i) % m_Capacity];
+		}
+
+		m_Items = items;
+		m_Capacity = capacity;
+		m_Head = 0;
+		m_Count = keep;
+	}
+
+	int Count()
+	{
+		return m_Count;
+	}
+
+	bool IsEmpty()
+	{
+		return m_Count == 0;
+	}
+
+	int GetCapacity()
+	{
+		return m_Capacity;
+	}
+
+	int GetHighWaterMark()
+	{
+		return m_HighWaterMark;
+	}
+
+	int GetOverflowCount()
+	{
+		return m_OverflowCount;
+	}
+
+	// Reset diagnostics (high-water mark restarts from the current depth)
+	void ResetStats()
+	{
+		m_HighWaterMark = m_Count;
+		m_OverflowCount = 0;
+	}
+}
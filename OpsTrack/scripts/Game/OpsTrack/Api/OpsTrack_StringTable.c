@@ -0,0 +1,125 @@
+// OpsTrack_StringTable.c
+// Incremental string dictionary for names, factions and weapons in batch payloads
+// Each distinct string gets a sequential id once; events and entities then send the id.
+// Every batch carries the entries the API hasn't acknowledged yet:
+//
+//   "strings":{"base":N,"values":["...",...]}   - values are ids N, N+1, ...
+//
+// base 0 is the full table (sent again after a reconnect and a journal replay). Journal segments and
+// failed batches kept for a resend carry a base 0 block too, so each of them can be replayed on its own.
+// The table starts empty with every mission.
+
+class OpsTrack_StringTable
+{
+	protected ref map<string, int> m_Ids;
+	protected ref array<string> m_Values;
+	protected int m_AckedCount;     // Entries [0, m_AckedCount) are known to the API
+	protected int m_Generation;     // Counts Clear() calls - ids of another generation mean something else
+	protected ref array<int> m_EndBytes;  // Serialized size of entries [0, i] (quotes and comma included)
+	protected int m_TotalBytes;
+
+	private static const int BLOCK_OVERHEAD_BYTES = 40;   // ,"strings":{"base":N,"values":[]}
+
+	void OpsTrack_StringTable()
+	{
+		m_Ids = new map<string, int>();
+		m_Values = new array<string>();
+		m_EndBytes = new array<int>();
+		m_AckedCount = 0;
+		m_TotalBytes = 0;
+		m_Generation = 0;
+	}
+
+	// New mission: start over with an empty table
+	void Clear()
+	{
+		m_Ids.Clear();
+		m_Values.Clear();
+		m_EndBytes.Clear();
+		m_AckedCount = 0;
+		m_TotalBytes = 0;
+		m_Generation++;
+	}
+
+	int GetGeneration()
+	{
+		return m_Generation;
+	}
+
+	// Id of a string, adding it on first use
+	int Intern(string value)
+	{
+		int id;
+		if (m_Ids.Find(value, id))
+			return id;
+
+		id = m_Values.Count();
+		m_Values.Insert(value);
+		m_Ids.Insert(value, id);
+		m_TotalBytes += value.Length() + 3;
+		m_EndBytes.Insert(m_TotalBytes);
+		return id;
+	}
+
+	int Count()
+	{
+		return m_Values.Count();
+	}
+
+	int GetAckedCount()
+	{
+		return m_AckedCount;
+	}
+
+	// A batch that carried entries up to count was accepted (ignored if the table was cleared since)
+	void Ack(int count, int generation)
+	{
+		if (generation == m_Generation && count > m_AckedCount)
+			m_AckedCount = count;
+	}
+
+	// The API may have lost the table - the next batch carries it in full
+	void ResendAll()
+	{
+		m_AckedCount = 0;
+	}
+
+	// Size of the block Write(writer, base) would produce right now (escaping aside), 0 if there is none
+	int GetBytesFrom(int base)
+	{
+		if (!HasEntriesFrom(base))
+			return 0;
+
+		int start = 0;
+		if (base > 0)
+			start = m_EndBytes[base - 1];
+		return m_TotalBytes - start + BLOCK_OVERHEAD_BYTES;
+	}
+
+	// Entries from base on that haven't been written yet
+	bool HasEntriesFrom(int base)
+	{
+		return base >= 0 && base < m_Values.Count();
+	}
+
+	// Write "strings":{...}, for entries from base up to count (-1 = all). Returns false (and writes nothing) if there are none.
+	bool Write(OpsTrack_PayloadWriter writer, int base, int count = -1)
+	{
+		if (count < 0 || count > m_Values.Count())
+			count = m_Values.Count();
+		if (base < 0 || base >= count)
+			return false;
+
+		writer.Append("\"strings\":{\"base\":");
+		writer.Append(base.ToString());
+		writer.Append(",\"values\":[");
+		for (int i = base; i < count; i++)
+		{
+			if (i > base)
+				writer.Append(",");
+			OpsTrack_JsonWriter.AppendEscaped(writer, m_Values[i]);
+		}
+		writer.Append("]}");
+		return true;
+	}
+}
@@ -0,0 +1,221 @@
+// OpsTrack_PayloadBenchmark.c
+// Compares batch payload builders and state encodings on synthetic entity states
+// Run on a server via #opstrack_bench [builder|encoding|all] (results go to the OpsTrack log)
+
+class OpsTrack_PayloadBenchmark
+{
+	// Encoding samples are spread over this many entities, like one capture per second of a full server
+	private static const int SAMPLE_ENTITIES = 64;
+	private static const int SAMPLE_MISSION_TIME_MS = 3600000; // Sample states one hour into a mission
+
+	// Batch sizes compared by default
+	static array<int> GetDefaultSizes()
+	{
+		array<int> sizes = {100, 500, 2000};
+		return sizes;
+	}
+
+	// Run the builder comparison for every size and return a one-line summary per size
+	static array<string> RunBuilderComparison(array<int> sizes)
+	{
+		array<string> results = {};
+
+		foreach (int size : sizes)
+		{
+			if (size <= 0)
+				continue;
+
+			array<string> states = CreateSampleStates(size);
+
+			// Repeat small batches so the tick counter has something to measure
+			int iterations = 4000 / size;
+			if (iterations < 1)
+				iterations = 1;
+
+			string legacyPayload;
+			int legacyStart = System.GetTickCount();
+			for (int i = 0; i < iterations; i++)
+			{
+				legacyPayload = BuildLegacy(states);
+			}
+			int legacyMs = System.GetTickCount() - legacyStart;
+
+			string writerPayload;
+			OpsTrack_PayloadWriter writer = new OpsTrack_PayloadWriter();
+			int writerStart = System.GetTickCount();
+			for (int j = 0; j < iterations; j++)
+			{
+				writerPayload = BuildWithWriter(writer, states);
+			}
+			int writerMs = System.GetTickCount() - writerStart;
+
+			string match = "match";
+			if (legacyPayload != writerPayload)
+				match = "MISMATCH";
+
+			string line = string.Format(
+				"builder %1 states x%2: legacy=%3 ms, writer=%4 ms, bytes=%5 (%6)",
+				size, iterations, legacyMs, writerMs, writerPayload.Length(), match
+			);
+
+			OpsTrackLogger.Info("Benchmark " + line);
+			results.Insert(line);
+		}
+
+		return results;
+	}
+
+	// Compare row and columnar state encoding size and build time for every size
+	static array<string> RunEncodingComparison(array<int> sizes)
+	{
+		array<string> results = {};
+		OpsTrack_PayloadWriter writer = new OpsTrack_PayloadWriter();
+		OpsTrack_JsonWriter json = new OpsTrack_JsonWriter(writer);
+		OpsTrack_ColumnarStateWriter columnar = new OpsTrack_ColumnarStateWriter();
+
+		foreach (int size : sizes)
+		{
+			if (size <= 0)
+				continue;
+
+			OpsTrack_StateQueue queue = CreateSampleQueue(size);
+
+			int iterations = 4000 / size;
+			if (iterations < 1)
+				iterations = 1;
+
+			string rowPayload;
+			int rowStart = System.GetTickCount();
+			for (int i = 0; i < iterations; i++)
+			{
+				writer.Reset();
+				writer.Append("\"states\":[");
+				for (int s = 0; s < queue.Count(); s++)
+				{
+					if (s > 0)
+						writer.Append(",");
+					queue.Get(s).Write(json);
+				}
+				writer.Append("]");
+				rowPayload = writer.Finish();
+			}
+			int rowMs = System.GetTickCount() - rowStart;
+
+			string columnarPayload;
+			int columnarStart = System.GetTickCount();
+			for (int j = 0; j < iterations; j++)
+			{
+				writer.Reset();
+				columnar.Write(writer, queue, queue.Count());
+				columnarPayload = writer.Finish();
+			}
+			int columnarMs = System.GetTickCount() - columnarStart;
+
+			float ratio = columnarPayload.Length();
+			ratio = ratio / rowPayload.Length();
+			int percent = Math.Round(ratio * 100);
+
+			string line = string.Format(
+				"encoding %1 states (%2 entities) x%3: row=%4 bytes/%5 ms, columnar=%6 bytes/%7 ms (%8% of row)",
+				size, SAMPLE_ENTITIES, iterations, rowPayload.Length(), rowMs, columnarPayload.Length(), columnarMs, percent
+			);
+
+			OpsTrackLogger.Info("Benchmark " + line);
+			results.Insert(line);
+		}
+
+		return results;
+	}
+
+	// Structured states for SAMPLE_ENTITIES entities, one sample per entity per second
+	protected static OpsTrack_StateQueue CreateSampleQueue(int count)
+	{
+		OpsTrack_StateQueue queue = new OpsTrack_StateQueue(count);
+		array<UUID> ids = {};
+		for (int e = 0; e < SAMPLE_ENTITIES; e++)
+		{
+			ids.Insert(UUID.GenV4());
+		}
+
+		int timestamp = SAMPLE_MISSION_TIME_MS;
+		for (int i = 0; i < count; i++)
+		{
+			OpsTrack_EntityState state = new OpsTrack_EntityState(
+				ids[i % SAMPLE_ENTITIES],
+				timestamp + (i / SAMPLE_ENTITIES) * 1000,
+				Math.RandomFloat(0, 12800),
+				Math.RandomFloat(0, 400),
+				Math.RandomFloat(0, 12800),
+				Math.RandomFloat(-180, 180),
+				true
+			);
+			queue.Push(state);
+		}
+
+		return queue;
+	}
+
+	// Synthetic player states with realistic value ranges
+	protected static array<string> CreateSampleStates(int count)
+	{
+		array<string> states = {};
+		int timestamp = SAMPLE_MISSION_TIME_MS;
+
+		for (int i = 0; i < count; i++)
+		{
+			OpsTrack_EntityState state = new OpsTrack_EntityState(
+				UUID.GenV4(),
+				timestamp,
+				Math.RandomFloat(0, 12800),
+				Math.RandomFloat(0, 400),
+				Math.RandomFloat(0, 12800),
+				Math.RandomFloat(-180, 180),
+				true
+			);
+			states.Insert(state.AsPayload());
+		}
+
+		return states;
+	}
+
+	// Copy of the pre-writer BuildUnifiedPayload string concatenation (states section)
+	protected static string BuildLegacy(array<string> states)
+	{
+		string payload = "{";
+		payload = payload + "\"missionId\":null,";
+		payload = payload + "\"entities\":[],";
+
+		payload = payload + "\"states\":[";
+		for (int s = 0; s < states.Count(); s++)
+		{
+			payload = payload + states[s];
+			if (s < states.Count() - 1)
+				payload = payload + ",";
+		}
+		payload = payload + "],";
+
+		payload = payload + "\"assignEntityIds\":[],";
+		payload = payload + "\"connectionEvents\":[],";
+		payload = payload + "\"combatEvents\":[]";
+		payload = payload + "}";
+
+		return payload;
+	}
+
+	// Same document built through OpsTrack_PayloadWriter
+	protected static string BuildWithWriter(OpsTrack_PayloadWriter writer, array<string> states)
+	{
+		writer.Reset();
+		writer.Append("{\"missionId\":null,\"entities\":[],\"states\":[");
+
+		for (int s = 0; s < states.Count(); s++)
+		{
+			if (s > 0)
+				writer.Append(",");
+			writer.Append(states[s]);
+		}
+
+		writer.Append("],\"assignEntityIds\":[],\"connectionEvents\":[],\"combatEvents\":[]}");
+		return writer.Finish();
+	}
+}
@@ -1,7 +1,7 @@
 // CombatEvent.c
 // Data class for combat events (kills, wounds, self-harm)
 
-class CombatEvent
+class CombatEvent : OpsTrack_PayloadRecord
 {
 	string actorUid;
 	string actorName;
@@ -12,10 +12,24 @@ class CombatEvent
 	string weapon;
 	int distance;
 	bool isBlueOnBlue;
-	string timeStamp;
+	int missionTimeMs;   // Milliseconds since mission start, or session start outside a recording (OpsTrack_MissionClock)
 	OpsTrack_EventType eventType;
+	int hits;            // Wounded summaries: hits, damage, distinct damage types and hit zones in the window
+	float totalDamage;
+	ref array<int> damageTypes;
+	ref array<string> hitZones;
+	ref OpsTrack_KillCamTrack actorTrack;   // Kill-cam segment (kills only, null if the actor wasn't in recent combat)
+	ref OpsTrack_KillCamTrack victimTrack;
 	
 	void CombatEvent(int actorId, string actorNameParam, string actorFactionNameParam, int victimId, string victimNameParam, string victimFactionNameParam, string weaponParam, int distanceParam, bool isBlueOnBlueParam, OpsTrack_EventType eventTypeParam)
+	{
+		damageTypes = new array<int>();
+		hitZones = new array<string>();
+		Set(actorId, actorNameParam, actorFactionNameParam, victimId, victimNameParam, victimFactionNameParam, weaponParam, distanceParam, isBlueOnBlueParam, eventTypeParam);
+	}
+	
+	// (Re)initialize - also used when the event comes from OpsTrack_CombatEventPool
+	void Set(int actorId, string actorNameParam, string actorFactionNameParam, int victimId, string victimNameParam, string victimFactionNameParam, string weaponParam, int distanceParam, bool isBlueOnBlueParam, OpsTrack_EventType eventTypeParam)
 	{
 		// Use safe getter for identity IDs
 		this.actorUid = OpsTrack_EntityUtils.GetPlayerIdentityIdSafe(actorId);
@@ -28,8 +42,14 @@ class CombatEvent
 		this.weapon = weaponParam;
 		this.distance = distanceParam;
 		this.isBlueOnBlue = isBlueOnBlueParam;
-		this.timeStamp = OpsTrack_DateTime.ToISO8601UTC();
+		this.missionTimeMs = OpsTrack_MissionClock.NowMs();
 		this.eventType = eventTypeParam;
+		this.hits = 0;
+		this.totalDamage = 0;
+		this.damageTypes.Clear();
+		this.hitZones.Clear();
+		this.actorTrack = null;
+		this.victimTrack = null;
 		
 		// Empty string for non-player entities (API expects empty or valid GUID)
 		if (!this.actorUid || this.actorUid == "0")
@@ -38,50 +58,104 @@ class CombatEvent
 		if (!this.victimUid || this.victimUid == "0")
 			this.victimUid = "";
 		
-		OpsTrackLogger.Debug(string.Format(
-			"CombatEvent created: actorId=%1, victimId=%2, eventType=%3", 
-			actorId, victimId, eventType
-		));
+		// Hot path - only format the message when it is logged
+		if (OpsTrackLogger.IsDebugEnabled())
+		{
+			OpsTrackLogger.Debug(string.Format(
+				"CombatEvent created: actorId=%1, victimId=%2, eventType=%3", 
+				actorId, victimId, eventType
+			));
+		}
 	}
 	
-	string AsPayload()
+	// Copied - the summary the values come from is recycled after sending
+	void SetHits(int hitCount, float damage, array<int> types, array<string> zones)
 	{
-		// Convert bool to lowercase string for JSON
-		string isTeamKillStr = "false";
-		if (isBlueOnBlue)
-			isTeamKillStr = "true";
-		
-		// Build JSON in parts to stay within string.Format limits
-		string part1 = string.Format(
-			"{" +
-				"\"actorId\":\"%1\"," +
-				"\"actorName\":\"%2\"," +
-				"\"actorFaction\":\"%3\"," +
-				"\"victimId\":\"%4\"," +
-				"\"victimName\":\"%5\"," +
-				"\"victimFaction\":\"%6\",",
-			actorUid,
-			actorName,
-			actorFactionName,
-			victimUid,
-			victimName,
-			victimFactionName
-		);
-		
-		string part2 = string.Format(
-			"\"weapon\":\"%1\"," +
-			"\"distance\":%2," +
-			"\"isTeamKill\":%3," +
-			"\"timeStamp\":\"%4\"," +
-			"\"eventTypeId\":%5" +
-			"}",
-			weapon,
-			distance,
-			isTeamKillStr,
-			timeStamp,
-			eventType
-		);
+		hits = hitCount;
+		totalDamage = damage;
+		damageTypes.Copy(types);
+		hitZones.Copy(zones);
+	}
+	
+	override void Recycle()
+	{
+		// Kill-cam tracks are the large part - don't keep them alive in the free list
+		actorTrack = null;
+		victimTrack = null;
+		OpsTrack_CombatEventPool.Get().Release(this);
+	}
+	
+	// strings: the ApiClient's string table, null to write names inline
+	override void Write(OpsTrack_JsonWriter json, OpsTrack_StringTable strings)
+	{
+		json.BeginObject();
+		json.WriteId("actorId", actorUid);
+		if (strings)
+		{
+			// Names, factions and weapon as string table ids
+			json.WriteInt("actorNameRef", strings.Intern(actorName));
+			json.WriteInt("actorFactionRef", strings.Intern(actorFactionName));
+			json.WriteId("victimId", victimUid);
+			json.WriteInt("victimNameRef", strings.Intern(victimName));
+			json.WriteInt("victimFactionRef", strings.Intern(victimFactionName));
+			json.WriteInt("weaponRef", strings.Intern(weapon));
+		}
+		else
+		{
+			json.WriteString("actorName", actorName);
+			json.WriteString("actorFaction", actorFactionName);
+			json.WriteId("victimId", victimUid);
+			json.WriteString("victimName", victimName);
+			json.WriteString("victimFaction", victimFactionName);
+			json.WriteString("weapon", weapon);
+		}
+		json.WriteInt("distance", distance);
+		json.WriteBool("isTeamKill", isBlueOnBlue);
+		json.WriteInt("missionTimeMs", missionTimeMs);
+		json.WriteInt("eventTypeId", eventType);
+		WriteDetails(json);
+		json.EndObject();
+	}
+	
+	// Optional parts: hit summary (wounded) and kill-cam tracks (kills)
+	protected void WriteDetails(OpsTrack_JsonWriter json)
+	{
+		// Hit summary of a coalesced wounded event
+		if (hits > 0)
+		{
+			json.WriteInt("hits", hits);
+			json.WriteFloat("damage", totalDamage, OpsTrack_JsonWriter.DAMAGE_DECIMALS);
+			
+			json.BeginArray("damageTypes");
+			foreach (int damageType : damageTypes)
+			{
+				json.WriteInt("", damageType);
+			}
+			json.EndArray();
+			
+			json.BeginArray("hitZones");
+			foreach (string zone : hitZones)
+			{
+				json.WriteString("", zone);
+			}
+			json.EndArray();
+		}
 		
-		return part1 + part2;
+		// Dense movement of both sides before a kill
+		if (actorTrack || victimTrack)
+		{
+			json.BeginObject("track");
+			WriteTrack(json, "actor", actorTrack);
+			WriteTrack(json, "victim", victimTrack);
+			json.EndObject();
+		}
+	}
+	
+	protected void WriteTrack(OpsTrack_JsonWriter json, string key, OpsTrack_KillCamTrack track)
+	{
+		if (track)
+			track.Write(json, key);
+		else
+			json.WriteNull(key);
 	}
 }
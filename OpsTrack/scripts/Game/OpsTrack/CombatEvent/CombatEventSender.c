@@ -6,20 +6,27 @@ class CombatEventSender
 	private static ref CombatEventSender s_Instance;
 	private OpsTrackSettings m_Settings;
 	
-	// Spam protection: map of "eventType:victimId:actorId" -> timestamp
-	// Only applies to WOUNDED events (prevents flood from explosions/fire)
-	private ref map<string, float> m_LastWoundedTime;
-	
-	private static const int CLEANUP_THRESHOLD = 100;
-	private static const int CLEANUP_AGE_MS = 60000; // 1 minute
-	private static const int SPAM_WINDOW_MS = 200;   // Minimum time between same victim/actor pair for WOUNDED
-	
-	private float m_LastCleanupTime;
+	// Wounded events are summarized per actor/victim pair (explosions, fire and bursts cause many hits)
+	private ref OpsTrack_WoundedCoalescer m_Wounded;
+	private ref array<ref OpsTrack_WoundedHits> m_ReadyWounded;   // Reused list of summaries being sent
+	private bool m_WoundedFlushScheduled;
+
+	// Raw hits from the OnDamage hook, enriched in batches outside the damage path
+	private ref OpsTrack_DamageQueue m_Damage;
+	private bool m_DamageScheduled;
+	private int m_DamageOverflows;      // Queue was full and had to be drained inside the hook
+
+	private static const int DAMAGE_QUEUE_CAPACITY = 1024;
+	private static const int DAMAGE_BATCH_BUDGET = 64;   // Records enriched per frame
 
 	private void CombatEventSender()
 	{
-		m_LastWoundedTime = new map<string, float>();
-		m_LastCleanupTime = 0;
+		m_Wounded = new OpsTrack_WoundedCoalescer();
+		m_ReadyWounded = new array<ref OpsTrack_WoundedHits>();
+		m_WoundedFlushScheduled = false;
+		m_Damage = new OpsTrack_DamageQueue(DAMAGE_QUEUE_CAPACITY);
+		m_DamageScheduled = false;
+		m_DamageOverflows = 0;
 		RefreshSettings();
 	}
 
@@ -39,32 +46,94 @@ class CombatEventSender
 	}
 
 	// --- Public API ---
-	void SendWounded(SCR_InstigatorContextData contextData)
+
+	// OnDamage hot path: copy the raw hit into the queue, nothing is resolved here
+	void RecordDamage(IEntity victim, IEntity attacker, Instigator instigator, float damage, EDamageType damageType, HitZone hitZone)
 	{
-		OpsTrackLogger.Debug("SendWounded called");
-		
-		// Wounded events use spam protection (grenades, fire, etc. cause many hits)
-		CombatEvent combatEvent = CreateCombatEvent(contextData, OpsTrack_EventType.WOUNDED, true);
-		if (!combatEvent)
+		OpsTrack_DamageRecord record = m_Damage.Reserve();
+		if (!record)
+		{
+			// Burst larger than the queue - enrich one batch now rather than drop hits
+			m_DamageOverflows++;
+			ProcessDamage(DAMAGE_BATCH_BUDGET);
+			record = m_Damage.Reserve();
+		}
+
+		record.Set(victim, attacker, instigator, damage, damageType, hitZone, OpsTrack_MissionClock.NowMs());
+
+		if (!m_DamageScheduled && GetGame() && GetGame().GetCallqueue())
 		{
-			OpsTrackLogger.Debug("Wounded event suppressed (spam protection or creation failed)");
+			m_DamageScheduled = true;
+			GetGame().GetCallqueue().CallLater(OnDamageBatch, 0, false);
+		}
+	}
+
+	// Enrich up to budget raw hits: combat marks for tracking, then wounded summaries
+	void ProcessDamage(int budget)
+	{
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (!manager)
 			return;
+
+		OpsTrack_EntityManager entityMgr = manager.GetEntityManager();
+		OpsTrack_StateTracker tracker = OpsTrack_StateTracker.Get();
+		bool woundedEvents = manager.GetSettings() && manager.GetSettings().EnableKillEvents;
+
+		for (int n = 0; n < budget && m_Damage.Count() > 0; n++)
+		{
+			ProcessDamageRecord(m_Damage.Front(), entityMgr, tracker, woundedEvents);
+			m_Damage.PopFront();
+		}
+	}
+	// Add a hit to the pair's summary; the summary is sent when the coalescing window ends
+	void SendWounded(SCR_InstigatorContextData contextData, float damage, EDamageType damageType, string hitZone, int missionTimeMs)
+	{
+		if (!contextData)
+		{
+			OpsTrackLogger.Warn("SendWounded called with null contextData");
+			return;
+		}
+
+		m_Wounded.Add(contextData, damage, damageType, hitZone, missionTimeMs);
+
+		int windowMs = GetWoundedWindowMs();
+		if (windowMs <= 0)
+		{
+			FlushWounded();
+			return;
+		}
+
+		if (!m_WoundedFlushScheduled && GetGame() && GetGame().GetCallqueue())
+		{
+			m_WoundedFlushScheduled = true;
+			GetGame().GetCallqueue().CallLater(FlushWounded, windowMs, false);
 		}
-		
-		SendCombatEvent(combatEvent);
 	}
 
 	void SendKill(SCR_InstigatorContextData contextData)
 	{
 		OpsTrackLogger.Debug("SendKill called");
+
+		// Wounds leading up to the kill go out first (including hits still in the raw queue)
+		ProcessDamage(m_Damage.Count());
+		if (contextData)
+			SendWoundedForVictim(contextData.GetVictimEntity());
 		
 		// Kill events are NEVER spam protected - a kill is always important
-		CombatEvent combatEvent = CreateCombatEvent(contextData, OpsTrack_EventType.KILL, false);
+		CombatEvent combatEvent = CreateCombatEvent(contextData, OpsTrack_EventType.KILL);
 		if (!combatEvent)
 		{
 			OpsTrackLogger.Debug("Kill event creation failed");
 			return;
 		}
+
+		// Attach the kill-cam window of both sides (the victim's buffer is no longer needed)
+		OpsTrack_StateTracker tracker = OpsTrack_StateTracker.Get();
+		if (tracker && tracker.IsTracking())
+		{
+			combatEvent.actorTrack = tracker.TakeKillCamSegment(contextData.GetKillerEntity(), false);
+			combatEvent.victimTrack = tracker.TakeKillCamSegment(contextData.GetVictimEntity(), true);
+		}
 		
 		SendCombatEvent(combatEvent);
 	}
@@ -72,9 +141,13 @@ class CombatEventSender
 	void SendSelfHarm(SCR_InstigatorContextData contextData)
 	{
 		OpsTrackLogger.Debug("SendSelfHarm called");
+
+		ProcessDamage(m_Damage.Count());
+		if (contextData)
+			SendWoundedForVictim(contextData.GetVictimEntity());
 		
 		// Self-harm events are NEVER spam protected
-		CombatEvent combatEvent = CreateCombatEvent(contextData, OpsTrack_EventType.SELF_HARM, false);
+		CombatEvent combatEvent = CreateCombatEvent(contextData, OpsTrack_EventType.SELF_HARM);
 		if (!combatEvent)
 		{
 			OpsTrackLogger.Debug("SelfHarm event creation failed");
@@ -84,8 +157,138 @@ class CombatEventSender
 		SendCombatEvent(combatEvent);
 	}
 	
+	// --- Damage Enrichment ---
+
+	protected void OnDamageBatch()
+	{
+		m_DamageScheduled = false;
+		ProcessDamage(DAMAGE_BATCH_BUDGET);
+
+		// Large burst - continue on the next frame
+		if (m_Damage.Count() > 0 && GetGame() && GetGame().GetCallqueue())
+		{
+			m_DamageScheduled = true;
+			GetGame().GetCallqueue().CallLater(OnDamageBatch, 0, false);
+		}
+	}
+
+	protected void ProcessDamageRecord(OpsTrack_DamageRecord record, OpsTrack_EntityManager entityMgr, OpsTrack_StateTracker tracker, bool woundedEvents)
+	{
+		// AI on either end of the hit switches to full-detail tracking
+		if (entityMgr)
+		{
+			entityMgr.MarkCombat(record.victim);
+			entityMgr.MarkCombat(record.attacker);
+		}
+
+		// Both sides get high-frequency samples in case this ends in a kill
+		if (tracker)
+		{
+			tracker.WatchCombatant(record.victim);
+			if (record.attacker != record.victim)
+				tracker.WatchCombatant(record.attacker);
+		}
+
+		if (!woundedEvents || !record.victim || !record.instigator)
+			return;
+
+		string hitZone = "";
+		if (record.hitZone)
+			hitZone = record.hitZone.GetName();
+
+		// Further hits on an open summary only add to its counters
+		if (m_Wounded.AddToPending(record.victim, record.attacker, record.damage, record.damageType, hitZone))
+			return;
+
+		int victimPlayerId = 0;
+		if (GetGame() && GetGame().GetPlayerManager())
+			victimPlayerId = GetGame().GetPlayerManager().GetPlayerIdFromControlledEntity(record.victim);
+
+		SCR_InstigatorContextData contextData = new SCR_InstigatorContextData(
+			victimPlayerId,
+			record.victim,
+			record.attacker,
+			record.instigator,
+			false
+		);
+
+		SendWounded(contextData, record.damage, record.damageType, hitZone, record.missionTimeMs);
+	}
+
+	// --- Wounded Coalescing ---
+
+	// Send every summary whose window is over and reschedule while hits are pending
+	protected void FlushWounded()
+	{
+		m_WoundedFlushScheduled = false;
+
+		int windowMs = GetWoundedWindowMs();
+		m_Wounded.TakeExpired(windowMs, m_ReadyWounded);
+		SendWoundedSummaries(m_ReadyWounded);
+
+		string report = m_Wounded.TakeReport();
+		if (report != "")
+			OpsTrackLogger.Debug(report);
+
+		if (m_Wounded.HasPending() && GetGame() && GetGame().GetCallqueue())
+		{
+			// Remaining pairs started later - check again within half a window
+			int delayMs = windowMs / 2;
+			if (delayMs < 50)
+				delayMs = 50;
+			m_WoundedFlushScheduled = true;
+			GetGame().GetCallqueue().CallLater(FlushWounded, delayMs, false);
+		}
+	}
+
+	// Send all pending summaries now (recording stops)
+	void FlushAllWounded()
+	{
+		ProcessDamage(m_Damage.Count());
+		if (m_DamageOverflows > 0)
+		{
+			OpsTrackLogger.Warn(string.Format("Damage queue overflowed %1 time(s) this mission (capacity %2)", m_DamageOverflows, DAMAGE_QUEUE_CAPACITY));
+			m_DamageOverflows = 0;
+		}
+
+		m_Wounded.TakeExpired(0, m_ReadyWounded);
+		SendWoundedSummaries(m_ReadyWounded);
+	}
+
+	protected void SendWoundedForVictim(IEntity victim)
+	{
+		m_Wounded.TakeVictim(victim, m_ReadyWounded);
+		SendWoundedSummaries(m_ReadyWounded);
+	}
+
+	// Sends and recycles the summaries (the list is empty afterwards)
+	protected void SendWoundedSummaries(array<ref OpsTrack_WoundedHits> summaries)
+	{
+		foreach (OpsTrack_WoundedHits summary : summaries)
+		{
+			CombatEvent combatEvent = CreateCombatEvent(summary.context, OpsTrack_EventType.WOUNDED);
+			if (!combatEvent)
+				continue;
+
+			combatEvent.missionTimeMs = summary.missionTimeMs;
+			combatEvent.SetHits(summary.hits, summary.damage, summary.damageTypes, summary.hitZones);
+			SendCombatEvent(combatEvent);
+		}
+
+		OpsTrack_WoundedHitsPool.Get().ReleaseAll(summaries);
+	}
+
+	protected int GetWoundedWindowMs()
+	{
+		if (!m_Settings)
+			RefreshSettings();
+		if (!m_Settings)
+			return 0;
+		return m_Settings.WoundedCoalesceWindowMs;
+	}
+
 	// --- Event Creation ---
-	protected CombatEvent CreateCombatEvent(SCR_InstigatorContextData contextData, OpsTrack_EventType eventType, bool useSpamProtection)
+	protected CombatEvent CreateCombatEvent(SCR_InstigatorContextData contextData, OpsTrack_EventType eventType)
 	{
 		if (!contextData)
 		{
@@ -97,54 +300,13 @@ class CombatEventSender
 		IEntity killerEntity = contextData.GetKillerEntity();
 		Instigator instigator = contextData.GetInstigator();
 		
-		// Get current time
-		float now = 0;
-		if (GetGame() && GetGame().GetWorld())
-			now = GetGame().GetWorld().GetWorldTime();
-		
-		// Periodic cleanup of old entries
-		if (m_LastWoundedTime.Count() > CLEANUP_THRESHOLD && (now - m_LastCleanupTime) > CLEANUP_AGE_MS)
-		{
-			CleanupOldEvents(now);
-			m_LastCleanupTime = now;
-		}
-		
 		// Get IDs
 		int victimId = contextData.GetVictimPlayerID();
 		int actorId = contextData.GetKillerPlayerID();
-		
-		// Spam protection - ONLY for wounded events
-		if (useSpamProtection)
-		{
-			string spamKey = string.Format("%1:%2", victimId, actorId);
-			if (m_LastWoundedTime.Contains(spamKey))
-			{
-				float lastTime = m_LastWoundedTime.Get(spamKey);
-				if (now - lastTime < SPAM_WINDOW_MS)
-				{
-					OpsTrackLogger.Debug(string.Format("Wounded event suppressed (spam): %1", spamKey));
-					return null;
-				}
-			}
-			m_LastWoundedTime.Set(spamKey, now);
-		}
 
-		// Resolve names using shared utility
+		// Resolve names using shared utility (memoized, player names included)
 		string victimName = OpsTrack_EntityUtils.ResolveCharacterName(victim);
-		if (victimId > 0)
-		{
-			string playerName = GetGame().GetPlayerManager().GetPlayerName(victimId);
-			if (playerName && playerName != "")
-				victimName = playerName;
-		}
-		
 		string actorName = OpsTrack_EntityUtils.ResolveCharacterName(killerEntity);
-		if (actorId > 0)
-		{
-			string playerName = GetGame().GetPlayerManager().GetPlayerName(actorId);
-			if (playerName && playerName != "")
-				actorName = playerName;
-		}
 
 		// Resolve factions using shared utility
 		string victimFactionName = "Unknown";
@@ -179,7 +341,7 @@ class CombatEventSender
 		}
 		
 		// Create and return event
-		return new CombatEvent(
+		return OpsTrack_CombatEventPool.Get().Acquire(
 			actorId, actorName, actorFactionName,
 			victimId, victimName, victimFactionName,
 			weaponName, distance, isTeamKill, eventType
@@ -207,10 +369,19 @@ class CombatEventSender
 			OpsTrackLogger.Warn("Settings were null, reloaded from OpsTrackManager");
 		}
 
-		string json = combatEvent.AsPayload();
-		OpsTrackLogger.Debug(string.Format("Combat event JSON: %1", json));
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		ApiClient api = null;
+		if (manager)
+			api = manager.GetApiClient();
 
-		OpsTrackLogger.Info(string.Format(
+		// Wounded summaries are frequent - only kills and self-harm are logged outside debug mode
+		// The event is serialized when the batch is built; the inline form here is for the log only
+		bool debug = OpsTrackLogger.IsDebugEnabled();
+		if (debug)
+			OpsTrackLogger.Debug(string.Format("Combat event JSON: %1", combatEvent.AsPayload()));
+
+		if (debug || combatEvent.eventType != OpsTrack_EventType.WOUNDED)
+			OpsTrackLogger.Info(string.Format(
 			"Sending CombatEvent: type=%1, actor=%2 (%3), victim=%4 (%5), weapon=%6, distance=%7m, teamkill=%8",
 			combatEvent.eventType,
 			combatEvent.actorName,
@@ -222,12 +393,10 @@ class CombatEventSender
 			combatEvent.isBlueOnBlue
 		));
 
-		OpsTrackManager manager = OpsTrackManager.GetIfExists();
 		if (manager)
 		{
-			ApiClient api = manager.GetApiClient();
 			if (api)
-				api.Enqueue(json, combatEvent.eventType);
+				api.Enqueue(combatEvent, combatEvent.eventType);
 			else
 				OpsTrackLogger.Error("ApiClient not available");
 		}
@@ -236,27 +405,4 @@ class CombatEventSender
 			OpsTrackLogger.Error("OpsTrackManager not available");
 		}
 	}
-	
-	// --- Cleanup ---
-	protected void CleanupOldEvents(float currentTime)
-	{
-		float threshold = currentTime - CLEANUP_AGE_MS;
-		
-		ref array<string> keysToRemove = new array<string>();
-		
-		foreach (string key, float timestamp : m_LastWoundedTime)
-		{
-			if (timestamp < threshold)
-				keysToRemove.Insert(key);
-		}
-		
-		foreach (string key : keysToRemove)
-		{
-			m_LastWoundedTime.Remove(key);
-		}
-		
-		int removedCount = keysToRemove.Count();
-		if (removedCount > 0)
-			OpsTrackLogger.Debug(string.Format("Cleaned up %1 old wounded event entries", removedCount));
-	}
 }
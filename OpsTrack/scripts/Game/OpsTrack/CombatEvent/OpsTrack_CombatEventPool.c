@@ -0,0 +1,26 @@
+// OpsTrack_CombatEventPool.c
+// Recycles combat events: taken by CombatEventSender, given back by the event queue once sent or dropped
+
+class OpsTrack_CombatEventPool : OpsTrack_ObjectPool
+{
+	protected static ref OpsTrack_CombatEventPool s_Instance;
+
+	private static const int MAX_FREE_EVENTS = 1024;
+
+	static OpsTrack_CombatEventPool Get()
+	{
+		if (!s_Instance)
+			s_Instance = new OpsTrack_CombatEventPool("Combat event", MAX_FREE_EVENTS);
+		return s_Instance;
+	}
+
+	CombatEvent Acquire(int actorId, string actorName, string actorFactionName, int victimId, string victimName, string victimFactionName, string weapon, int distance, bool isBlueOnBlue, OpsTrack_EventType eventType)
+	{
+		CombatEvent combatEvent = CombatEvent.Cast(TakeFree());
+		if (!combatEvent)
+			return new CombatEvent(actorId, actorName, actorFactionName, victimId, victimName, victimFactionName, weapon, distance, isBlueOnBlue, eventType);
+
+		combatEvent.Set(actorId, actorName, actorFactionName, victimId, victimName, victimFactionName, weapon, distance, isBlueOnBlue, eventType);
+		return combatEvent;
+	}
+}
@@ -0,0 +1,94 @@
+// OpsTrack_DamageQueue.c
+// Preallocated ring of raw damage records written by the OnDamage hook
+// The hook only copies references and numbers; names, factions, weapons and JSON are
+// resolved later by CombatEventSender.ProcessDamage in budgeted batches.
+
+class OpsTrack_DamageRecord
+{
+	IEntity victim;
+	IEntity attacker;
+	ref Instigator instigator;
+	float damage;
+	EDamageType damageType;
+	HitZone hitZone;
+	int missionTimeMs;
+
+	void Set(IEntity victimEntity, IEntity attackerEntity, Instigator source, float damageValue, EDamageType type, HitZone zone, int timeMs)
+	{
+		victim = victimEntity;
+		attacker = attackerEntity;
+		instigator = source;
+		damage = damageValue;
+		damageType = type;
+		hitZone = zone;
+		missionTimeMs = timeMs;
+	}
+
+	// Drop references so a processed slot doesn't keep an Instigator alive
+	void Clear()
+	{
+		victim = null;
+		attacker = null;
+		instigator = null;
+		hitZone = null;
+	}
+}
+
+class OpsTrack_DamageQueue
+{
+	protected ref array<ref OpsTrack_DamageRecord> m_Records;
+	protected int m_Head;      // Oldest record
+	protected int m_Count;
+	protected int m_Capacity;
+
+	void OpsTrack_DamageQueue(int capacity)
+	{
+		m_Capacity = capacity;
+		m_Records = new array<ref OpsTrack_DamageRecord>();
+		for (int i = 0; i < capacity; i++)
+		{
+			m_Records.Insert(new OpsTrack_DamageRecord());
+		}
+		m_Head = 0;
+		m_Count = 0;
+	}
+
+	int Count()
+	{
+		return m_Count;
+	}
+
+	bool IsFull()
+	{
+		return m_Count >= m_Capacity;
+	}
+
+	// Slot for the next record (null when full - the caller drains first)
+	OpsTrack_DamageRecord Reserve()
+	{
+		if (m_Count >= m_Capacity)
+			return null;
+
+		OpsTrack_DamageRecord record = m_Records[(m_Head + m_Count) % m_Capacity];
+		m_Count++;
+		return record;
+	}
+
+	// Oldest record (valid until the next Reserve)
+	OpsTrack_DamageRecord Front()
+	{
+		if (m_Count == 0)
+			return null;
+		return m_Records[m_Head];
+	}
+
+	void PopFront()
+	{
+		if (m_Count == 0)
+			return;
+
+		m_Records[m_Head].Clear();
+		m_Head = (m_Head + 1) % m_Capacity;
+		m_Count--;
+	}
+}
@@ -0,0 +1,249 @@
+// OpsTrack_WoundedCoalescer.c
+// Accumulates hits per actor/victim pair and releases one summary per pair and window
+// Shotguns, fire and explosions produce many hits in a few frames; all of them are counted
+// instead of being dropped, and sustained fire becomes one event per window.
+// Summaries are pooled; a hit on a pair that already has one allocates nothing.
+
+class OpsTrack_WoundedHits
+{
+	ref SCR_InstigatorContextData context;   // First hit of the window (entities, player ids, instigator)
+	int firstTick;
+	int missionTimeMs;                       // Time of the first hit (the summary's event time)
+	int hits;
+	float damage;
+	ref array<int> damageTypes;              // Distinct EDamageType values
+	ref array<string> hitZones;              // Distinct hit zone names
+
+	void OpsTrack_WoundedHits(SCR_InstigatorContextData contextData, int tick, int hitTimeMs)
+	{
+		damageTypes = new array<int>();
+		hitZones = new array<string>();
+		Reset(contextData, tick, hitTimeMs);
+	}
+
+	void Reset(SCR_InstigatorContextData contextData, int tick, int hitTimeMs)
+	{
+		context = contextData;
+		firstTick = tick;
+		missionTimeMs = hitTimeMs;
+		hits = 0;
+		damage = 0;
+		damageTypes.Clear();
+		hitZones.Clear();
+	}
+
+	void Add(float hitDamage, EDamageType damageType, string hitZone)
+	{
+		hits++;
+		damage += hitDamage;
+
+		if (damageTypes.Find(damageType) < 0)
+			damageTypes.Insert(damageType);
+
+		if (hitZone != "" && hitZones.Find(hitZone) < 0)
+			hitZones.Insert(hitZone);
+	}
+}
+
+class OpsTrack_WoundedHitsPool : OpsTrack_ObjectPool
+{
+	protected static ref OpsTrack_WoundedHitsPool s_Instance;
+
+	private static const int MAX_FREE_SUMMARIES = 256;
+
+	static OpsTrack_WoundedHitsPool Get()
+	{
+		if (!s_Instance)
+			s_Instance = new OpsTrack_WoundedHitsPool("Wounded summary", MAX_FREE_SUMMARIES);
+		return s_Instance;
+	}
+
+	OpsTrack_WoundedHits Acquire(SCR_InstigatorContextData contextData, int tick, int hitTimeMs)
+	{
+		OpsTrack_WoundedHits entry = OpsTrack_WoundedHits.Cast(TakeFree());
+		if (!entry)
+			return new OpsTrack_WoundedHits(contextData, tick, hitTimeMs);
+
+		entry.Reset(contextData, tick, hitTimeMs);
+		return entry;
+	}
+
+	// Give summaries back once their events are built (their context is dropped here)
+	void ReleaseAll(notnull array<ref OpsTrack_WoundedHits> summaries)
+	{
+		foreach (OpsTrack_WoundedHits entry : summaries)
+		{
+			entry.context = null;
+			Release(entry);
+		}
+		summaries.Clear();
+	}
+}
+
+class OpsTrack_WoundedCoalescer
+{
+	// Open summaries per victim, one per actor - looked up by entity, no key strings per hit
+	protected ref map<IEntity, ref array<ref OpsTrack_WoundedHits>> m_Pending;
+	protected ref array<ref array<ref OpsTrack_WoundedHits>> m_FreeLists;  // Emptied victim lists, reused
+	protected ref array<IEntity> m_Victims;  // Scratch list for TakeExpired
+
+	// Volume counters (since the last report)
+	protected int m_HitsIn;
+	protected int m_SummariesOut;
+
+	void OpsTrack_WoundedCoalescer()
+	{
+		m_Pending = new map<IEntity, ref array<ref OpsTrack_WoundedHits>>();
+		m_FreeLists = new array<ref array<ref OpsTrack_WoundedHits>>();
+		m_Victims = new array<IEntity>();
+		m_HitsIn = 0;
+		m_SummariesOut = 0;
+	}
+
+	// Add a hit to its pair's summary
+	void Add(SCR_InstigatorContextData contextData, float hitDamage, EDamageType damageType, string hitZone, int hitTimeMs)
+	{
+		IEntity victim = contextData.GetVictimEntity();
+		OpsTrack_WoundedHits entry = FindPending(victim, contextData.GetKillerEntity());
+		if (!entry)
+		{
+			entry = OpsTrack_WoundedHitsPool.Get().Acquire(contextData, System.GetTickCount(), hitTimeMs);
+
+			array<ref OpsTrack_WoundedHits> victimHits = m_Pending.Get(victim);
+			if (!victimHits)
+			{
+				victimHits = TakeFreeList();
+				m_Pending.Insert(victim, victimHits);
+			}
+			victimHits.Insert(entry);
+		}
+
+		entry.Add(hitDamage, damageType, hitZone);
+		m_HitsIn++;
+	}
+
+	// Add a hit to a summary that is already open for the pair; false if there is none yet
+	// (the caller then builds the context for the first hit and calls Add)
+	bool AddToPending(IEntity victim, IEntity actor, float hitDamage, EDamageType damageType, string hitZone)
+	{
+		OpsTrack_WoundedHits entry = FindPending(victim, actor);
+		if (!entry)
+			return false;
+
+		entry.Add(hitDamage, damageType, hitZone);
+		m_HitsIn++;
+		return true;
+	}
+
+	bool HasPending()
+	{
+		return m_Pending.Count() > 0;
+	}
+
+	// Move summaries whose window is over (all of them with windowMs 0) into out
+	void TakeExpired(int windowMs, notnull array<ref OpsTrack_WoundedHits> out)
+	{
+		int tick = System.GetTickCount();
+		m_Victims.Clear();
+		foreach (IEntity victim, array<ref OpsTrack_WoundedHits> victimHits : m_Pending)
+		{
+			int i = 0;
+			while (i < victimHits.Count())
+			{
+				OpsTrack_WoundedHits entry = victimHits[i];
+				if (tick - entry.firstTick < windowMs)
+				{
+					i++;
+					continue;
+				}
+
+				out.Insert(entry);
+				victimHits.RemoveOrdered(i);
+				m_SummariesOut++;
+			}
+
+			if (victimHits.IsEmpty())
+				m_Victims.Insert(victim);
+		}
+
+		foreach (IEntity doneVictim : m_Victims)
+		{
+			RemoveVictim(doneVictim);
+		}
+	}
+
+	// Move every summary for this victim into out (the victim died - wounds go out before the kill)
+	void TakeVictim(IEntity victim, notnull array<ref OpsTrack_WoundedHits> out)
+	{
+		if (!victim)
+			return;
+
+		array<ref OpsTrack_WoundedHits> victimHits = m_Pending.Get(victim);
+		if (!victimHits)
+			return;
+
+		foreach (OpsTrack_WoundedHits entry : victimHits)
+		{
+			out.Insert(entry);
+		}
+		m_SummariesOut += victimHits.Count();
+
+		RemoveVictim(victim);
+	}
+
+	void Clear()
+	{
+		m_Pending.Clear();
+	}
+
+	// "Wounded: N hits -> M events" since the last call, "" if nothing happened
+	string TakeReport()
+	{
+		if (m_HitsIn == 0)
+			return "";
+
+		string report = string.Format("Wounded coalescing: %1 hits -> %2 events", m_HitsIn, m_SummariesOut);
+		m_HitsIn = 0;
+		m_SummariesOut = 0;
+		return report;
+	}
+
+	// Entities rather than player ids, so AI pairs don't collapse into one "0:0" pair
+	protected OpsTrack_WoundedHits FindPending(IEntity victim, IEntity actor)
+	{
+		array<ref OpsTrack_WoundedHits> victimHits = m_Pending.Get(victim);
+		if (!victimHits)
+			return null;
+
+		// A victim has few attackers at a time
+		foreach (OpsTrack_WoundedHits entry : victimHits)
+		{
+			if (entry.context.GetKillerEntity() == actor)
+				return entry;
+		}
+		return null;
+	}
+
+	protected array<ref OpsTrack_WoundedHits> TakeFreeList()
+	{
+		int last = m_FreeLists.Count() - 1;
+		if (last < 0)
+			return new array<ref OpsTrack_WoundedHits>();
+
+		array<ref OpsTrack_WoundedHits> victimHits = m_FreeLists[last];
+		m_FreeLists.Remove(last);
+		return victimHits;
+	}
+
+	// Drop the victim's list (its summaries were moved out) and keep it for the next victim
+	protected void RemoveVictim(IEntity victim)
+	{
+		array<ref OpsTrack_WoundedHits> victimHits = m_Pending.Get(victim);
+		if (!victimHits)
+			return;
+
+		victimHits.Clear();
+		m_FreeLists.Insert(victimHits);
+		m_Pending.Remove(victim);
+	}
+}
@@ -1,34 +1,28 @@
 // ConnectionEvent.c
 // Data class for player connection events (join/leave)
 
-class ConnectionEvent
+class ConnectionEvent : OpsTrack_PayloadRecord
 {
 	string GameIdentity;
 	string Name;
 	OpsTrack_EventType EventTypeId;
-	string TimeStamp;
+	int MissionTimeMs;   // Milliseconds since mission start, or session start outside a recording (OpsTrack_MissionClock)
 	
 	void ConnectionEvent(string gameIdentity, string name, OpsTrack_EventType eventTypeId)
 	{
 		this.GameIdentity = gameIdentity;
 		this.Name = name;
 		this.EventTypeId = eventTypeId;
-		this.TimeStamp = OpsTrack_DateTime.ToISO8601UTC();
+		this.MissionTimeMs = OpsTrack_MissionClock.NowMs();
 	}
 	
-	string AsPayload()
+	override void Write(OpsTrack_JsonWriter json, OpsTrack_StringTable strings)
 	{
-		return string.Format(
-			"{" + 
-				"\"gameIdentity\":\"%1\"," + 
-				"\"name\":\"%2\"," +
-				"\"timeStamp\":\"%3\"," +
-				"\"eventTypeId\":%4" +
-			"}",
-			GameIdentity,
-			Name,
-			TimeStamp,
-			EventTypeId
-		);
+		json.BeginObject();
+		json.WriteId("gameIdentity", GameIdentity);
+		json.WriteString("name", Name);
+		json.WriteInt("missionTimeMs", MissionTimeMs);
+		json.WriteInt("eventTypeId", EventTypeId);
+		json.EndObject();
 	}
 }
@@ -77,7 +77,6 @@ class ConnectionEventSender
 
 		// Create and send event
 		ConnectionEvent cEvent = new ConnectionEvent(gameIdentity, name, eventType);
-		string json = cEvent.AsPayload();
 
 		OpsTrackLogger.Info(string.Format(
 			"Sending '%1' event for player '%2' (UID: %3).",
@@ -89,7 +88,7 @@ class ConnectionEventSender
 		{
 			ApiClient api = manager.GetApiClient();
 			if (api)
-				api.Enqueue(json, eventType);
+				api.Enqueue(cEvent, eventType);
 			else
 				OpsTrackLogger.Error("ApiClient not available");
 		}
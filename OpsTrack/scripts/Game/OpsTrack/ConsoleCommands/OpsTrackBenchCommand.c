@@ -0,0 +1,89 @@
+// OpsTrackBenchCommand.c
+// RCON and chat command to run OpsTrack payload benchmarks on the server
+// Usage: #opstrack_bench [builder|encoding|all]  (default: builder)
+
+class OpsTrackBenchCommand : ScrServerCommand
+{
+	override string GetKeyword()
+	{
+		return "opstrack_bench";
+	}
+
+	override bool IsServerSide()
+	{
+		return true;
+	}
+
+	override int RequiredRCONPermission()
+	{
+		return ERCONPermissions.PERMISSIONS_ADMIN;
+	}
+
+	override int RequiredChatPermission()
+	{
+		return EPlayerRole.ADMINISTRATOR;
+	}
+
+	override ref ScrServerCmdResult OnUpdate()
+	{
+		return new ScrServerCmdResult("No update required", EServerCmdResultType.OK);
+	}
+
+	override ref ScrServerCmdResult OnRCONExecution(array<string> argv)
+	{
+		return ExecuteBench(argv, -1);
+	}
+
+	override ref ScrServerCmdResult OnChatServerExecution(array<string> argv, int playerId)
+	{
+		if (!GetGame() || !GetGame().GetPlayerManager())
+			return new ScrServerCmdResult("Game not ready.", EServerCmdResultType.ERR);
+
+		if (!GetGame().GetPlayerManager().HasPlayerRole(playerId, EPlayerRole.ADMINISTRATOR))
+		{
+			OpsTrackLogger.Warn(string.Format("Player %1 attempted to run benchmarks without admin permissions.", playerId));
+			return new ScrServerCmdResult("You are not an administrator.", EServerCmdResultType.MISSING_PERMISSION);
+		}
+
+		return ExecuteBench(argv, playerId);
+	}
+
+	override ref ScrServerCmdResult OnChatClientExecution(array<string> argv, int playerId)
+	{
+		return new ScrServerCmdResult("", EServerCmdResultType.OK);
+	}
+
+	private ref ScrServerCmdResult ExecuteBench(array<string> argv, int playerId)
+	{
+		if (playerId > 0)
+			OpsTrackLogger.Info(string.Format("Payload benchmark started by player %1", playerId));
+		else
+			OpsTrackLogger.Info("Payload benchmark started via RCON");
+
+		string mode = "builder";
+		if (argv && argv.Count() > 1)
+			mode = argv[1];
+
+		array<int> sizes = OpsTrack_PayloadBenchmark.GetDefaultSizes();
+		array<string> results = {};
+
+		if (mode == "builder" || mode == "all")
+			results.InsertAll(OpsTrack_PayloadBenchmark.RunBuilderComparison(sizes));
+
+		if (mode == "encoding" || mode == "all")
+			results.InsertAll(OpsTrack_PayloadBenchmark.RunEncodingComparison(sizes));
+
+		if (results.IsEmpty())
+			return new ScrServerCmdResult("Usage: #opstrack_bench [builder|encoding|all]", EServerCmdResultType.ERR);
+
+		string msg = "";
+		foreach (string line : results)
+		{
+			if (msg != "")
+				msg += "\n";
+			msg += line;
+		}
+
+		return new ScrServerCmdResult(msg, EServerCmdResultType.OK);
+	}
+}
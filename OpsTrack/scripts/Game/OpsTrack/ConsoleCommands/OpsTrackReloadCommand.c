@@ -91,5 +91,9 @@ class OpsTrackReloadCommand : ScrServerCommand
 		CombatEventSender combatSender = CombatEventSender.Get();
 		if (combatSender)
 			combatSender.RefreshSettings();
+
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (manager && manager.GetApiClient())
+			manager.GetApiClient().ApplySettings(manager.GetSettings());
 	}
 }
@@ -0,0 +1,43 @@
+// OpsTrack_CrewAssignment.c
+// Data class for the crew of a vehicle at one point in time
+// Occupants aren't sent as separate states while seated - their position is the vehicle's
+
+class OpsTrack_CrewAssignment : OpsTrack_PayloadRecord
+{
+	UUID vehicleId;
+	int timestamp;  // Milliseconds since mission start (OpsTrack_MissionClock)
+	ref array<string> occupantIds;
+	ref array<int> seats;       // Compartment index per occupant
+
+	void OpsTrack_CrewAssignment(UUID id, int ts)
+	{
+		vehicleId = id;
+		timestamp = ts;
+		occupantIds = {};
+		seats = {};
+	}
+
+	void AddOccupant(string entityId, int seat)
+	{
+		occupantIds.Insert(entityId);
+		seats.Insert(seat);
+	}
+
+	// Compact seat list: {"vehicleId":"...","timestamp":N,"seats":[["<entityId>",<seat>],...]}
+	override void Write(OpsTrack_JsonWriter json, OpsTrack_StringTable strings)
+	{
+		json.BeginObject();
+		json.WriteId("vehicleId", string.Format("%1", vehicleId));
+		json.WriteInt("timestamp", timestamp);
+		json.BeginArray("seats");
+		for (int i = 0; i < occupantIds.Count(); i++)
+		{
+			json.BeginArray();
+			json.WriteId("", occupantIds[i]);
+			json.WriteInt("", seats[i]);
+			json.EndArray();
+		}
+		json.EndArray();
+		json.EndObject();
+	}
+}
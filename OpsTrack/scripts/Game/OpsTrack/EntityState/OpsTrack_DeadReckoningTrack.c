@@ -0,0 +1,26 @@
+// OpsTrack_DeadReckoningTrack.c
+// Last emitted state and estimated velocity of one entity (used by OpsTrack_StateFilter)
+
+class OpsTrack_DeadReckoningTrack
+{
+	// Last emitted sample
+	vector emittedPos;
+	float emittedRotation;
+	bool emittedAlive;
+	int emittedTick;
+
+	// Velocity (m/s) at the time of the last emission
+	vector velocity;
+
+	// Last captured sample (emitted or not) - velocity is measured between consecutive captures
+	vector lastPos;
+	int lastTick;
+
+	// Position the replay would show at tick if no new sample is sent
+	vector Extrapolate(int tick)
+	{
+		float dt = tick - emittedTick;
+		dt = dt / 1000;
+		return emittedPos + velocity * dt;
+	}
+}
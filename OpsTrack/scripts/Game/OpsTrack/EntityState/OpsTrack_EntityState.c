@@ -4,7 +4,7 @@
 class OpsTrack_EntityState
 {
 	UUID entityId;
-	int timestamp;  // Unix timestamp in seconds
+	int timestamp;  // Milliseconds since mission start (OpsTrack_MissionClock)
 	float posX;
 	float posY;
 	float posZ;
@@ -12,6 +12,12 @@ class OpsTrack_EntityState
 	bool isAlive;
 
 	void OpsTrack_EntityState(UUID id, int ts, float x, float y, float z, float rot, bool alive)
+	{
+		Set(id, ts, x, y, z, rot, alive);
+	}
+
+	// (Re)initialize - also used when the state comes from OpsTrack_StatePool
+	void Set(UUID id, int ts, float x, float y, float z, float rot, bool alive)
 	{
 		entityId = id;
 		timestamp = ts;
@@ -22,29 +28,24 @@ class OpsTrack_EntityState
 		isAlive = alive;
 	}
 
-	string AsPayload()
+	void Write(OpsTrack_JsonWriter json)
 	{
-		string aliveStr = "false";
-		if (isAlive)
-			aliveStr = "true";
+		json.BeginObject();
+		json.WriteId("entityId", string.Format("%1", entityId));
+		json.WriteInt("timestamp", timestamp);
+		json.WriteFloat("posX", posX, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		json.WriteFloat("posY", posY, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		json.WriteFloat("posZ", posZ, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		json.WriteFloat("rotation", rotation, OpsTrack_JsonWriter.ANGLE_DECIMALS);
+		json.WriteBool("isAlive", isAlive);
+		json.EndObject();
+	}
 
-		return string.Format(
-			"{" +
-				"\"entityId\":\"%1\"," +
-				"\"timestamp\":%2," +
-				"\"posX\":%3," +
-				"\"posY\":%4," +
-				"\"posZ\":%5," +
-				"\"rotation\":%6," +
-				"\"isAlive\":%7" +
-			"}",
-			entityId,
-			timestamp,
-			posX,
-			posY,
-			posZ,
-			rotation,
-			aliveStr
-		);
+	// The state on its own - batches use Write
+	string AsPayload()
+	{
+		OpsTrack_JsonWriter json = new OpsTrack_JsonWriter();
+		Write(json);
+		return json.Finish();
 	}
 }
@@ -0,0 +1,51 @@
+// OpsTrack_GroupState.c
+// Data class for the aggregate state of an AI group (one sample instead of one per member)
+
+class OpsTrack_GroupState : OpsTrack_PayloadRecord
+{
+	UUID groupId;
+	int timestamp;  // Milliseconds since mission start (OpsTrack_MissionClock)
+	float posX;     // Centroid of alive members
+	float posY;
+	float posZ;
+	float spread;   // Largest distance of an alive member from the centroid (meters)
+	int members;
+	int alive;
+
+	void OpsTrack_GroupState(UUID id, int ts, vector centroid, float spreadMeters, int memberCount, int aliveCount)
+	{
+		Set(id, ts, centroid, spreadMeters, memberCount, aliveCount);
+	}
+
+	// (Re)initialize - also used when the state comes from OpsTrack_GroupStatePool
+	void Set(UUID id, int ts, vector centroid, float spreadMeters, int memberCount, int aliveCount)
+	{
+		groupId = id;
+		timestamp = ts;
+		posX = centroid[0];
+		posY = centroid[1];
+		posZ = centroid[2];
+		spread = spreadMeters;
+		members = memberCount;
+		alive = aliveCount;
+	}
+
+	override void Write(OpsTrack_JsonWriter json, OpsTrack_StringTable strings)
+	{
+		json.BeginObject();
+		json.WriteId("groupId", string.Format("%1", groupId));
+		json.WriteInt("timestamp", timestamp);
+		json.WriteFloat("posX", posX, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		json.WriteFloat("posY", posY, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		json.WriteFloat("posZ", posZ, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		json.WriteFloat("spread", spread, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		json.WriteInt("members", members);
+		json.WriteInt("alive", alive);
+		json.EndObject();
+	}
+
+	override void Recycle()
+	{
+		OpsTrack_GroupStatePool.Get().Release(this);
+	}
+}
@@ -0,0 +1,26 @@
+// OpsTrack_GroupStatePool.c
+// Recycles AI group states: taken by the capture loop, given back by the group state queue once sent or dropped
+
+class OpsTrack_GroupStatePool : OpsTrack_ObjectPool
+{
+	protected static ref OpsTrack_GroupStatePool s_Instance;
+
+	private static const int MAX_FREE_GROUP_STATES = 2048;
+
+	static OpsTrack_GroupStatePool Get()
+	{
+		if (!s_Instance)
+			s_Instance = new OpsTrack_GroupStatePool("Group state", MAX_FREE_GROUP_STATES);
+		return s_Instance;
+	}
+
+	OpsTrack_GroupState Acquire(UUID id, int ts, vector centroid, float spreadMeters, int memberCount, int aliveCount)
+	{
+		OpsTrack_GroupState groupState = OpsTrack_GroupState.Cast(TakeFree());
+		if (!groupState)
+			return new OpsTrack_GroupState(id, ts, centroid, spreadMeters, memberCount, aliveCount);
+
+		groupState.Set(id, ts, centroid, spreadMeters, memberCount, aliveCount);
+		return groupState;
+	}
+}
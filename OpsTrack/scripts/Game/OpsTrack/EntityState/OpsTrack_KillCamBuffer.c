@@ -0,0 +1,79 @@
+// OpsTrack_KillCamBuffer.c
+// Fixed-size ring of high-frequency position samples for one entity involved in combat
+// The arrays are sized once at construction, so memory per entity never grows.
+
+class OpsTrack_KillCamBuffer
+{
+	IEntity entity;
+	int activeUntilTick;      // Sampled until this tick (extended by every hit)
+
+	protected ref array<int> m_Tick;
+	protected ref array<float> m_X;
+	protected ref array<float> m_Y;
+	protected ref array<float> m_Z;
+	protected ref array<float> m_Rotation;
+	protected int m_Capacity;
+	protected int m_Head;     // Next write position
+	protected int m_Count;
+
+	void OpsTrack_KillCamBuffer(int capacity)
+	{
+		m_Capacity = capacity;
+		m_Tick = new array<int>();
+		m_X = new array<float>();
+		m_Y = new array<float>();
+		m_Z = new array<float>();
+		m_Rotation = new array<float>();
+		m_Tick.Resize(capacity);
+		m_X.Resize(capacity);
+		m_Y.Resize(capacity);
+		m_Z.Resize(capacity);
+		m_Rotation.Resize(capacity);
+	}
+
+	// Start over for a new entity (buffers are recycled between combatants)
+	void Assign(IEntity newEntity, int untilTick)
+	{
+		entity = newEntity;
+		activeUntilTick = untilTick;
+		m_Head = 0;
+		m_Count = 0;
+	}
+
+	void Sample(int tick)
+	{
+		if (!entity)
+			return;
+
+		vector pos = entity.GetOrigin();
+		vector angles = entity.GetYawPitchRoll();
+
+		m_Tick[m_Head] = tick;
+		m_X[m_Head] = pos[0];
+		m_Y[m_Head] = pos[1];
+		m_Z[m_Head] = pos[2];
+		m_Rotation[m_Head] = angles[0];
+
+		m_Head = (m_Head + 1) % m_Capacity;
+		if (m_Count < m_Capacity)
+			m_Count++;
+	}
+
+	int Count()
+	{
+		return m_Count;
+	}
+
+	// Dense segment, oldest sample first. Times are milliseconds relative to eventTick (<= 0).
+	OpsTrack_KillCamTrack TakeTrack(int eventTick)
+	{
+		OpsTrack_KillCamTrack track = new OpsTrack_KillCamTrack();
+		int start = (m_Head - m_Count + m_Capacity) % m_Capacity;
+		for (int i = 0; i < m_Count; i++)
+		{
+			int slot = (start + i) % m_Capacity;
+			track.Add(m_Tick[slot] - eventTick, m_X[slot], m_Y[slot], m_Z[slot], m_Rotation[slot]);
+		}
+		return track;
+	}
+}
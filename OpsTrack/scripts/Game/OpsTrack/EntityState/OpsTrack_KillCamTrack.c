@@ -0,0 +1,65 @@
+// OpsTrack_KillCamTrack.c
+// Kill-cam samples of one side of a kill, copied out of its buffer when the kill happens
+// (buffers are recycled) and written into the combat event when the batch is built.
+// {"dtMs":[-9900,...],"x":[...],"y":[...],"z":[...],"r":[...]}
+
+class OpsTrack_KillCamTrack
+{
+	protected ref array<int> m_DtMs;      // Milliseconds relative to the kill (<= 0)
+	protected ref array<float> m_X;
+	protected ref array<float> m_Y;
+	protected ref array<float> m_Z;
+	protected ref array<float> m_Rotation;
+
+	void OpsTrack_KillCamTrack()
+	{
+		m_DtMs = new array<int>();
+		m_X = new array<float>();
+		m_Y = new array<float>();
+		m_Z = new array<float>();
+		m_Rotation = new array<float>();
+	}
+
+	void Add(int dtMs, float x, float y, float z, float rotation)
+	{
+		m_DtMs.Insert(dtMs);
+		m_X.Insert(x);
+		m_Y.Insert(y);
+		m_Z.Insert(z);
+		m_Rotation.Insert(rotation);
+	}
+
+	int Count()
+	{
+		return m_DtMs.Count();
+	}
+
+	void Write(OpsTrack_JsonWriter json, string key)
+	{
+		json.BeginObject(key);
+
+		json.BeginArray("dtMs");
+		foreach (int dtMs : m_DtMs)
+		{
+			json.WriteInt("", dtMs);
+		}
+		json.EndArray();
+
+		WriteColumn(json, "x", m_X, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		WriteColumn(json, "y", m_Y, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		WriteColumn(json, "z", m_Z, OpsTrack_JsonWriter.POSITION_DECIMALS);
+		WriteColumn(json, "r", m_Rotation, OpsTrack_JsonWriter.ANGLE_DECIMALS);
+
+		json.EndObject();
+	}
+
+	protected void WriteColumn(OpsTrack_JsonWriter json, string key, array<float> values, int decimals)
+	{
+		json.BeginArray(key);
+		foreach (float value : values)
+		{
+			json.WriteFloat("", value, decimals);
+		}
+		json.EndArray();
+	}
+}
@@ -0,0 +1,132 @@
+// OpsTrack_StateFilter.c
+// Dead-band / dead-reckoning filter for captured entity states
+// A sample is only emitted when the position predicted from the last emitted sample and velocity
+// is off by more than the distance threshold, the heading changed by more than the angle threshold,
+// the alive flag changed, or the keyframe interval expired. Idle and straight-moving entities
+// produce far fewer states while the replay (linear interpolation) stays within the thresholds.
+
+// Per-entity tracks live on the registry records (OpsTrack_TrackedEntity), so no lookup is needed.
+
+class OpsTrack_StateFilter
+{
+	protected bool m_Enabled;
+	protected float m_DistanceThreshold;   // Meters
+	protected float m_AngleThreshold;      // Degrees
+	protected int m_MaxIntervalMs;
+
+	// Statistics since last reset
+	protected int m_Captured;
+	protected int m_Emitted;
+
+	void OpsTrack_StateFilter()
+	{
+		m_Enabled = true;
+		m_DistanceThreshold = 1.0;
+		m_AngleThreshold = 10.0;
+		m_MaxIntervalMs = 10000;
+		m_Captured = 0;
+		m_Emitted = 0;
+	}
+
+	void Configure(bool enabled, float distanceThreshold, float angleThreshold, int maxIntervalSeconds)
+	{
+		m_Enabled = enabled;
+		m_DistanceThreshold = distanceThreshold;
+		m_AngleThreshold = angleThreshold;
+		m_MaxIntervalMs = maxIntervalSeconds * 1000;
+	}
+
+	// Decide whether this capture should be queued. tick = System.GetTickCount() of the capture.
+	// force: the sample is sent regardless - the track is still updated to it
+	bool ShouldEmit(OpsTrack_DeadReckoningTrack track, vector pos, float rotation, bool isAlive, int tick, bool force = false)
+	{
+		m_Captured++;
+
+		// Nothing emitted yet for this entity, or the caller sends this sample anyway
+		if (!m_Enabled || track.emittedTick == 0 || force)
+		{
+			Emit(track, pos, rotation, isAlive, tick);
+			return true;
+		}
+
+		bool emit = false;
+		if (isAlive != track.emittedAlive)
+			emit = true;
+		else if (tick - track.emittedTick >= m_MaxIntervalMs)
+			emit = true;
+		else if (vector.Distance(pos, track.Extrapolate(tick)) > m_DistanceThreshold)
+			emit = true;
+		else if (Math.AbsFloat(AngleDelta(rotation, track.emittedRotation)) > m_AngleThreshold)
+			emit = true;
+
+		if (emit)
+		{
+			Emit(track, pos, rotation, isAlive, tick);
+			return true;
+		}
+
+		track.lastPos = pos;
+		track.lastTick = tick;
+		return false;
+	}
+
+	// Reset statistics (tracks are reset with their registry records)
+	void Reset()
+	{
+		m_Captured = 0;
+		m_Emitted = 0;
+	}
+
+	int GetCapturedCount()
+	{
+		return m_Captured;
+	}
+
+	int GetEmittedCount()
+	{
+		return m_Emitted;
+	}
+
+	string GetReport()
+	{
+		int suppressed = 0;
+		if (m_Captured > 0)
+		{
+			float ratio = m_Captured - m_Emitted;
+			ratio = ratio / m_Captured;
+			suppressed = Math.Round(ratio * 100);
+		}
+
+		return string.Format("State filter: emitted %1 of %2 captured states (%3% suppressed)", m_Emitted, m_Captured, suppressed);
+	}
+
+	protected void Emit(OpsTrack_DeadReckoningTrack track, vector pos, float rotation, bool isAlive, int tick)
+	{
+		// Velocity from the two most recent captures; a dead entity doesn't move on
+		track.velocity = vector.Zero;
+		if (isAlive && track.lastTick > 0 && tick > track.lastTick)
+		{
+			float dt = tick - track.lastTick;
+			track.velocity = (pos - track.lastPos) * (1000 / dt);
+		}
+
+		track.emittedPos = pos;
+		track.emittedRotation = rotation;
+		track.emittedAlive = isAlive;
+		track.emittedTick = tick;
+		track.lastPos = pos;
+		track.lastTick = tick;
+		m_Emitted++;
+	}
+
+	// Signed difference between two headings in degrees, in [-180, 180]
+	protected static float AngleDelta(float a, float b)
+	{
+		float delta = a - b;
+		while (delta > 180)
+			delta -= 360;
+		while (delta < -180)
+			delta += 360;
+		return delta;
+	}
+}
@@ -0,0 +1,26 @@
+// OpsTrack_StatePool.c
+// Recycles entity states: taken by the capture loop, given back by the state queue once sent or dropped
+
+class OpsTrack_StatePool : OpsTrack_ObjectPool
+{
+	protected static ref OpsTrack_StatePool s_Instance;
+
+	private static const int MAX_FREE_STATES = 5000;
+
+	static OpsTrack_StatePool Get()
+	{
+		if (!s_Instance)
+			s_Instance = new OpsTrack_StatePool("Entity state", MAX_FREE_STATES);
+		return s_Instance;
+	}
+
+	OpsTrack_EntityState Acquire(UUID id, int ts, float x, float y, float z, float rot, bool alive)
+	{
+		OpsTrack_EntityState state = OpsTrack_EntityState.Cast(TakeFree());
+		if (!state)
+			return new OpsTrack_EntityState(id, ts, x, y, z, rot, alive);
+
+		state.Set(id, ts, x, y, z, rot, alive);
+		return state;
+	}
+}
@@ -7,14 +7,53 @@ class OpsTrack_StateTracker
 
 	private bool m_IsTracking;
 	private int m_UpdateIntervalMs;
+	private ref OpsTrack_StateFilter m_Filter;  // Dead-band: skips states the replay can extrapolate
+	private bool m_TrackVehicles;
+	private bool m_TrackAi;
+	private float m_AiDetailDistanceSq;      // AI members this close to a player get full detail
+	private ref array<vector> m_PlayerPositions; // Refreshed at the start of each capture cycle
+	private ref array<AIAgent> m_Agents;         // Scratch list for SyncGroupMembers
+
+	// Kill-cam: 10 Hz samples of recently damaged entities, attached to kill events
+	private bool m_KillCamEnabled;
+	private bool m_KillCamSampling;
+	private ref array<ref OpsTrack_KillCamBuffer> m_KillCams;
+
+	// Capture cycle - the entity registry is snapshotted once per interval and walked with a cursor
+	// (weak refs: a record removed mid-cycle becomes null and is skipped)
+	private ref array<OpsTrack_TrackedEntity> m_CaptureList;
+	private int m_CaptureCursor;
+	private int m_SliceSize;           // Entities per frame (0 = whole cycle in one frame)
+
+	// Per-frame cost (ms, tick counter resolution)
+	private int m_CycleFrames;
+	private int m_CycleWorstFrameMs;
+	private int m_WorstFrameMs;        // Worst frame since tracking started
+	private int m_WorstFrameEntities;  // Entities captured in that frame
 
 	private static const int DEFAULT_UPDATE_INTERVAL_MS = 1000; // 1 second - capture positions every second
 	// Note: We no longer batch in StateTracker - ApiClient handles all batching via unified flush
+	private static const int KILLCAM_INTERVAL_MS = 100;    // 10 Hz
+	private static const int KILLCAM_WINDOW_MS = 10000;    // Sampled this long after the last hit
+	private static const int KILLCAM_CAPACITY = 100;       // Samples per entity (window / interval)
+	private static const int KILLCAM_MAX_ENTITIES = 32;    // Buffers in the pool, the least recently hit is recycled
 
 	private void OpsTrack_StateTracker()
 	{
 		m_IsTracking = false;
 		m_UpdateIntervalMs = DEFAULT_UPDATE_INTERVAL_MS;
+		m_Filter = new OpsTrack_StateFilter();
+		m_CaptureList = new array<OpsTrack_TrackedEntity>();
+		m_CaptureCursor = 0;
+		m_SliceSize = 0;
+		m_TrackVehicles = true;
+		m_TrackAi = true;
+		m_AiDetailDistanceSq = 300 * 300;
+		m_PlayerPositions = new array<vector>();
+		m_Agents = new array<AIAgent>();
+		m_KillCamEnabled = true;
+		m_KillCamSampling = false;
+		m_KillCams = new array<ref OpsTrack_KillCamBuffer>();
 	}
 
 	static OpsTrack_StateTracker Get()
@@ -44,6 +83,36 @@ class OpsTrack_StateTracker
 		}
 
 		m_IsTracking = true;
+
+		m_Filter.Reset();
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (manager && manager.GetSettings())
+		{
+			OpsTrackSettings settings = manager.GetSettings();
+			m_Filter.Configure(settings.EnableStateDeadband, settings.DeadbandDistanceM, settings.DeadbandAngleDeg, settings.MaxStateIntervalS);
+
+			m_SliceSize = 0;
+			if (settings.EnableSlicedCapture)
+				m_SliceSize = settings.MaxCapturesPerFrame;
+
+			m_TrackVehicles = settings.EnableVehicleTracking;
+			m_TrackAi = settings.EnableAiTracking;
+			m_AiDetailDistanceSq = settings.AiDetailDistanceM * settings.AiDetailDistanceM;
+			m_KillCamEnabled = settings.EnableKillCam && settings.EnableKillEvents;
+		}
+
+		// Registry is kept up to date by the game mode hooks; pick up anyone who was missed
+		if (manager && manager.GetEntityManager())
+		{
+			manager.GetEntityManager().SyncTrackedPlayers();
+			manager.GetEntityManager().ResetTrackedStates();
+		}
+
+		m_CaptureList.Clear();
+		m_CaptureCursor = 0;
+		m_WorstFrameMs = 0;
+		m_WorstFrameEntities = 0;
+
 		OpsTrackLogger.Info("EntityState tracking started");
 
 		// Schedule first position capture (one-shot, will reschedule itself)
@@ -75,6 +144,16 @@ class OpsTrack_StateTracker
 
 		m_IsTracking = false;
 
+		if (GetGame() && GetGame().GetCallqueue())
+		{
+			GetGame().GetCallqueue().Remove(CaptureSlice);
+			GetGame().GetCallqueue().Remove(SampleKillCams);
+		}
+		m_KillCamSampling = false;
+		m_KillCams.Clear();
+		m_CaptureList.Clear();
+		m_CaptureCursor = 0;
+
 		// Force flush any remaining states before stopping
 		OpsTrackManager manager = OpsTrackManager.GetIfExists();
 		if (manager)
@@ -84,6 +163,14 @@ class OpsTrack_StateTracker
 				api.ForceFlush();
 		}
 
+		if (m_Filter.GetCapturedCount() > 0)
+		{
+			OpsTrackLogger.Info(m_Filter.GetReport());
+			OpsTrackLogger.Info(string.Format("Capture cost: worst frame %1 ms (%2 entities, slice size %3)",
+				m_WorstFrameMs, m_WorstFrameEntities, m_SliceSize));
+		}
+		m_Filter.Reset();
+
 		OpsTrackLogger.Info("EntityState tracking stopped");
 	}
 
@@ -92,7 +179,109 @@ class OpsTrack_StateTracker
 		return m_IsTracking;
 	}
 
-	// Capture positions of all tracked entities
+	// Damage hook: sample this entity at high frequency for the next KILLCAM_WINDOW_MS
+	void WatchCombatant(IEntity entity)
+	{
+		if (!m_IsTracking || !m_KillCamEnabled || !entity)
+			return;
+
+		int tick = System.GetTickCount();
+		OpsTrack_KillCamBuffer buffer = FindKillCam(entity);
+		if (buffer)
+		{
+			buffer.activeUntilTick = tick + KILLCAM_WINDOW_MS;
+		}
+		else
+		{
+			buffer = AcquireKillCam(tick);
+			buffer.Assign(entity, tick + KILLCAM_WINDOW_MS);
+			buffer.Sample(tick);
+		}
+
+		if (!m_KillCamSampling && GetGame() && GetGame().GetCallqueue())
+		{
+			m_KillCamSampling = true;
+			GetGame().GetCallqueue().CallLater(SampleKillCams, KILLCAM_INTERVAL_MS, true);
+		}
+	}
+
+	// Dense track of the last seconds of an entity hit within the window (null if there is none).
+	// Called for kills; the victim's buffer is released afterwards.
+	OpsTrack_KillCamTrack TakeKillCamSegment(IEntity entity, bool release)
+	{
+		OpsTrack_KillCamBuffer buffer = FindKillCam(entity);
+		if (!buffer)
+			return null;
+
+		int tick = System.GetTickCount();
+		if (tick > buffer.activeUntilTick)
+			return null;
+
+		buffer.Sample(tick);
+		OpsTrack_KillCamTrack segment = buffer.TakeTrack(tick);
+
+		if (release)
+			buffer.Assign(null, 0);
+
+		return segment;
+	}
+
+	protected OpsTrack_KillCamBuffer FindKillCam(IEntity entity)
+	{
+		if (!entity)
+			return null;
+
+		foreach (OpsTrack_KillCamBuffer buffer : m_KillCams)
+		{
+			if (buffer.entity == entity)
+				return buffer;
+		}
+		return null;
+	}
+
+	// Free or expired buffer, a new one while under the budget, otherwise the least recently hit
+	protected OpsTrack_KillCamBuffer AcquireKillCam(int tick)
+	{
+		OpsTrack_KillCamBuffer oldest = null;
+		foreach (OpsTrack_KillCamBuffer buffer : m_KillCams)
+		{
+			if (!buffer.entity || tick > buffer.activeUntilTick)
+				return buffer;
+			if (!oldest || buffer.activeUntilTick < oldest.activeUntilTick)
+				oldest = buffer;
+		}
+
+		if (m_KillCams.Count() < KILLCAM_MAX_ENTITIES)
+		{
+			OpsTrack_KillCamBuffer created = new OpsTrack_KillCamBuffer(KILLCAM_CAPACITY);
+			m_KillCams.Insert(created);
+			return created;
+		}
+
+		return oldest;
+	}
+
+	// Repeating 10 Hz sampler, stops itself once no buffer is active
+	protected void SampleKillCams()
+	{
+		int tick = System.GetTickCount();
+		bool active = false;
+		foreach (OpsTrack_KillCamBuffer buffer : m_KillCams)
+		{
+			if (!buffer.entity || tick > buffer.activeUntilTick)
+				continue;
+			buffer.Sample(tick);
+			active = true;
+		}
+
+		if (!active)
+		{
+			m_KillCamSampling = false;
+			GetGame().GetCallqueue().Remove(SampleKillCams);
+		}
+	}
+
+	// Start a capture cycle: snapshot the registry, then capture all at once or a slice per frame
 	protected void CaptureAllPositions()
 	{
 		// Reschedule next capture FIRST (ensures continuous operation even if we return early)
@@ -113,79 +302,524 @@ class OpsTrack_StateTracker
 		if (!entityMgr)
 			return;
 
-		// Get current timestamp (seconds since epoch)
-		int timestamp = System.GetUnixTime();
+		// Previous cycle still running (slice too small for the player count) - finish it now, nothing is dropped
+		if (m_CaptureCursor < m_CaptureList.Count())
+		{
+			OpsTrackLogger.Warn(string.Format("Capture cycle overran: %1 entities left, finishing in this frame. Consider raising MaxCapturesPerFrame.",
+				m_CaptureList.Count() - m_CaptureCursor));
+			GetGame().GetCallqueue().Remove(CaptureSlice);
+			CaptureNext(m_CaptureList.Count());
+			FinishCycle();
+		}
+
+		m_CaptureList.Clear();
+		m_PlayerPositions.Clear();
+		foreach (OpsTrack_TrackedEntity tracked : entityMgr.GetTrackedEntities())
+		{
+			// Vehicles stay registered (seat lookups) but aren't visited while vehicle tracking is off
+			if (!m_TrackVehicles && tracked.type == OpsTrack_EntityType.VEHICLE)
+				continue;
+
+			m_CaptureList.Insert(tracked);
+			if (tracked.playerId > 0 && tracked.entity)
+				m_PlayerPositions.Insert(tracked.entity.GetOrigin());
+		}
+		m_CaptureCursor = 0;
+		m_CycleFrames = 0;
+		m_CycleWorstFrameMs = 0;
+
+		if (m_SliceSize <= 0)
+		{
+			CaptureNext(m_CaptureList.Count());
+			FinishCycle();
+			return;
+		}
+
+		CaptureSlice();
+	}
+
+	// Capture the next slice and continue on the next frame until the list is done
+	protected void CaptureSlice()
+	{
+		if (!m_IsTracking)
+			return;
+
+		CaptureNext(m_SliceSize);
+
+		if (m_CaptureCursor < m_CaptureList.Count())
+		{
+			GetGame().GetCallqueue().CallLater(CaptureSlice, 0, false);
+			return;
+		}
+
+		FinishCycle();
+	}
+
+	// Capture up to count entities from the cursor and record the frame cost
+	protected void CaptureNext(int count)
+	{
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (!manager || !manager.IsRecording())
+			return;
+
+		OpsTrack_EntityManager entityMgr = manager.GetEntityManager();
+		if (!entityMgr)
+			return;
+
+		ApiClient api = manager.GetApiClient();
+
+		int frameStart = System.GetTickCount();
+		int end = m_CaptureCursor + count;
+		if (end > m_CaptureList.Count())
+			end = m_CaptureList.Count();
+
+		int captured = end - m_CaptureCursor;
+		while (m_CaptureCursor < end)
+		{
+			CaptureRecord(m_CaptureList[m_CaptureCursor], manager, entityMgr, api);
+			m_CaptureCursor++;
+		}
+
+		int frameMs = System.GetTickCount() - frameStart;
+		m_CycleFrames++;
+		if (frameMs > m_CycleWorstFrameMs)
+			m_CycleWorstFrameMs = frameMs;
+		if (frameMs > m_WorstFrameMs)
+		{
+			m_WorstFrameMs = frameMs;
+			m_WorstFrameEntities = captured;
+		}
+	}
+
+	// All entities of this cycle captured - report and check if it's time to flush
+	protected void FinishCycle()
+	{
+		OpsTrackLogger.Debug(string.Format("Capture cycle: %1 entities in %2 frame(s), worst frame %3 ms",
+			m_CaptureList.Count(), m_CycleFrames, m_CycleWorstFrameMs));
+
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (!manager)
+			return;
+
+		ApiClient api = manager.GetApiClient();
+		if (api)
+			api.CheckAndFlush();
+	}
 
-		// Get all player entities and their controlled characters
-		PlayerManager playerMgr = GetGame().GetPlayerManager();
-		if (!playerMgr)
+	// Capture one tracked entity's state. Each sample gets the time it was actually taken.
+	// Everything needed comes from the registry record - no player or component lookups.
+	protected void CaptureRecord(OpsTrack_TrackedEntity record, OpsTrackManager manager, OpsTrack_EntityManager entityMgr, ApiClient api)
+	{
+		if (!record)
 			return;
 
-		array<int> playerIds = {};
-		playerMgr.GetPlayers(playerIds);
+		if (record.type == OpsTrack_EntityType.VEHICLE)
+		{
+			CaptureVehicle(record, manager, entityMgr, api);
+			return;
+		}
 
-		foreach (int playerId : playerIds)
+		if (record.IsGroup())
 		{
-			IEntity controlledEntity = playerMgr.GetPlayerControlledEntity(playerId);
-			if (!controlledEntity)
+			CaptureAiGroup(record, manager, entityMgr, api);
+			return;
+		}
+
+		// Not controlling anything (player between lives)
+		if (!record.entity)
+			return;
+
+		// Seated characters are covered by the vehicle's state and crew assignment
+		if (m_TrackVehicles && UpdateSeat(record, entityMgr))
+			return;
+
+		// Entity ids are cleared between recordings - recreate on first capture (handles Game Master spawns, etc.)
+		if (record.entityId.IsNull() && record.playerId > 0)
+			EnsurePlayerEntity(record, manager, entityMgr, api);
+
+		if (record.entityId.IsNull())
+			return;
+
+		// Get position
+		vector pos = record.entity.GetOrigin();
+
+		// Get rotation (yaw)
+		vector angles = record.entity.GetYawPitchRoll();
+		float rotation = angles[0]; // Yaw
+
+		// Alive: death hook plus the cached controller
+		bool isAlive = record.isAlive;
+		if (isAlive && record.controller && record.controller.IsDead())
+			isAlive = false;
+
+		// Skip the sample if the replay can extrapolate it from the last one
+		if (!m_Filter.ShouldEmit(record.deadReckoning, pos, rotation, isAlive, System.GetTickCount()))
+			return;
+
+		// Create state
+		OpsTrack_EntityState state = OpsTrack_StatePool.Get().Acquire(
+			record.entityId,
+			OpsTrack_MissionClock.NowMs(),
+			pos[0], pos[1], pos[2],
+			rotation,
+			isAlive
+		);
+		record.lastStateMs = state.timestamp;
+
+		// Queue state directly to ApiClient (it handles batching)
+		if (api)
+			api.EnqueueEntityState(state);
+	}
+
+	// Create the OpsTrack entity of a player record and assign it to the mission
+	protected void EnsurePlayerEntity(OpsTrack_TrackedEntity record, OpsTrackManager manager, OpsTrack_EntityManager entityMgr, ApiClient api)
+	{
+		string playerName = GetGame().GetPlayerManager().GetPlayerName(record.playerId);
+		string factionName = "Unknown";
+		Faction faction = OpsTrack_EntityUtils.GetFaction(record.entity, record.playerId);
+		if (faction)
+			factionName = faction.GetFactionName();
+
+		entityMgr.GetOrCreatePlayerEntity(record.playerId, playerName, factionName);
+
+		// Queue entity assignment to current mission (ApiClient handles batching)
+		if (!record.entityId.IsNull() && manager.IsRecording() && api)
+			api.EnqueueEntityAssignment(record.entityIdStr);
+	}
+
+	// Vehicle capture with level of detail: sample interval from speed and occupancy, seats on crew change
+	protected void CaptureVehicle(OpsTrack_TrackedEntity record, OpsTrackManager manager, OpsTrack_EntityManager entityMgr, ApiClient api)
+	{
+		// Vehicle deleted - drop the record
+		if (!record.entity)
+		{
+			entityMgr.RemoveRecord(record);
+			return;
+		}
+
+		int tick = System.GetTickCount();
+		if (!m_TrackVehicles || (tick < record.nextSampleTick && !record.crewDirty))
+			return;
+
+		if (record.entityId.IsNull())
+		{
+			entityMgr.GetOrCreateVehicleEntity(record);
+			if (!record.entityId.IsNull() && manager.IsRecording() && api)
+				api.EnqueueEntityAssignment(record.entityIdStr);
+		}
+
+		if (record.entityId.IsNull())
+			return;
+
+		if (record.crewDirty)
+			SendCrew(record, manager, entityMgr, api);
+
+		float speed = record.GetSpeed();
+		record.nextSampleTick = tick + OpsTrack_VehicleLod.GetSampleIntervalMs(speed, record.occupants > 0, record.isAircraft);
+
+		vector pos = record.entity.GetOrigin();
+		vector angles = record.entity.GetYawPitchRoll();
+		float rotation = angles[0]; // Yaw
+
+		if (!m_Filter.ShouldEmit(record.deadReckoning, pos, rotation, record.isAlive, tick))
+			return;
+
+		OpsTrack_EntityState state = OpsTrack_StatePool.Get().Acquire(
+			record.entityId,
+			OpsTrack_MissionClock.NowMs(),
+			pos[0], pos[1], pos[2],
+			rotation,
+			record.isAlive
+		);
+		record.lastStateMs = state.timestamp;
+
+		if (api)
+			api.EnqueueEntityState(state);
+	}
+
+	// AI group: one aggregate state per group, full detail only for members in combat or near a player
+	protected void CaptureAiGroup(OpsTrack_TrackedEntity record, OpsTrackManager manager, OpsTrack_EntityManager entityMgr, ApiClient api)
+	{
+		// Group deleted (or made playable after spawn) - drop the record together with its members
+		if (!record.group || record.group.IsPlayable())
+		{
+			entityMgr.RemoveRecord(record);
+			return;
+		}
+
+		if (!m_TrackAi)
+			return;
+
+		SyncGroupMembers(record);
+
+		// Centroid and spread of the alive members
+		vector centroid = vector.Zero;
+		int alive = 0;
+		foreach (OpsTrack_TrackedEntity member : record.members)
+		{
+			if (!member.isAlive)
 				continue;
+			centroid = centroid + member.entity.GetOrigin();
+			alive++;
+		}
+
+		// Wiped out and already reported
+		if (alive == 0 && record.lastAliveCount == 0)
+			return;
+
+		if (alive > 0)
+			centroid = centroid * (1.0 / alive);
+		else
+			centroid = record.entity.GetOrigin();
+
+		float spread = 0;
+		foreach (OpsTrack_TrackedEntity m : record.members)
+		{
+			if (!m.isAlive)
+				continue;
+			float distance = vector.Distance(m.entity.GetOrigin(), centroid);
+			if (distance > spread)
+				spread = distance;
+		}
+
+		if (record.entityId.IsNull())
+		{
+			entityMgr.GetOrCreateAiEntity(record);
+			if (!record.entityId.IsNull() && manager.IsRecording() && api)
+				api.EnqueueEntityAssignment(record.entityIdStr);
+		}
+
+		if (record.entityId.IsNull())
+			return;
+
+		// Aggregate goes through the dead-band like any other state; a member count change always goes out
+		// (forced through the filter so the track extrapolates from what was sent)
+		int tick = System.GetTickCount();
+		bool countChanged = alive != record.lastAliveCount;
+		if (m_Filter.ShouldEmit(record.deadReckoning, centroid, 0, alive > 0, tick, countChanged))
+		{
+			record.lastAliveCount = alive;
+			OpsTrack_GroupState groupState = OpsTrack_GroupStatePool.Get().Acquire(record.entityId, OpsTrack_MissionClock.NowMs(), centroid, spread, record.members.Count(), alive);
+			if (api)
+				api.EnqueueGroupState(groupState);
+		}
 
-			UUID entityId = entityMgr.GetEntityId(playerId);
+		// Nobody can be near a player if the whole group is out of range
+		bool groupNearPlayer = IsNearPlayer(centroid, spread);
+		foreach (OpsTrack_TrackedEntity detail : record.members)
+		{
+			// Seated members are covered by the vehicle's state and crew assignment
+			if (m_TrackVehicles && UpdateSeat(detail, entityMgr))
+				continue;
 
-			// If player doesn't have an entity yet, create one (handles Game Master spawns, etc.)
-			if (entityId.IsNull())
+			bool inCombat = tick < detail.combatUntilTick;
+			bool wasDetailed = detail.lastStateMs >= 0;
+			if (!inCombat && !(groupNearPlayer && IsNearPlayer(detail.entity.GetOrigin(), 0)))
 			{
-				string playerName = playerMgr.GetPlayerName(playerId);
-				string factionName = "Unknown";
-				Faction faction = OpsTrack_EntityUtils.GetFaction(controlledEntity, playerId);
-				if (faction)
-					factionName = faction.GetFactionName();
+				// Left full detail - the next time it enters, start a fresh track
+				if (wasDetailed)
+				{
+					detail.lastStateMs = -1;
+					detail.deadReckoning = new OpsTrack_DeadReckoningTrack();
+				}
+				continue;
+			}
 
-				entityId = entityMgr.GetOrCreatePlayerEntity(playerId, playerName, factionName);
+			CaptureAiMember(detail, manager, entityMgr, api, tick);
+		}
+	}
 
-				// Queue entity assignment to current mission (ApiClient handles batching)
-				if (!entityId.IsNull() && manager.IsRecording())
+	// Match member records to the group's current agents. Records of members that died
+	// (and were removed from the group) stay until their entity is deleted so they count as dead.
+	protected void SyncGroupMembers(OpsTrack_TrackedEntity record)
+	{
+		for (int i = record.members.Count() - 1; i >= 0; i--)
+		{
+			OpsTrack_TrackedEntity member = record.members[i];
+			if (!member.entity)
+			{
+				LeaveVehicle(member);
+				record.members.Remove(i);
+				continue;
+			}
+			member.isAlive = false;
+		}
+
+		m_Agents.Clear();
+		record.group.GetAgents(m_Agents);
+		foreach (AIAgent agent : m_Agents)
+		{
+			if (!agent)
+				continue;
+
+			IEntity controlled = agent.GetControlledEntity();
+			if (!controlled)
+				continue;
+
+			// A player controls this character (possession) - it is tracked as the player
+			bool playerControlled = SCR_PossessingManagerComponent.GetPlayerIdFromControlledEntity(controlled) > 0;
+
+			OpsTrack_TrackedEntity found = null;
+			for (int m = 0; m < record.members.Count(); m++)
+			{
+				if (record.members[m].entity != controlled)
+					continue;
+
+				if (playerControlled)
 				{
-					ApiClient api = manager.GetApiClient();
-					if (api)
-						api.EnqueueEntityAssignment(string.Format("%1", entityId));
+					LeaveVehicle(record.members[m]);
+					record.members.Remove(m);
 				}
+				else
+					found = record.members[m];
+				break;
 			}
 
-			// Get position
-			vector pos = controlledEntity.GetOrigin();
-
-			// Get rotation (yaw)
-			vector angles = controlledEntity.GetYawPitchRoll();
-			float rotation = angles[0]; // Yaw
-
-			// Check if alive
-			bool isAlive = true;
-			SCR_CharacterControllerComponent controller = SCR_CharacterControllerComponent.Cast(
-				controlledEntity.FindComponent(SCR_CharacterControllerComponent)
-			);
-			if (controller)
-				isAlive = !controller.IsDead();
-
-			// Create state
-			OpsTrack_EntityState state = new OpsTrack_EntityState(
-				entityId,
-				timestamp,
-				pos[0], pos[1], pos[2],
-				rotation,
-				isAlive
-			);
-
-			// Queue state directly to ApiClient (it handles batching)
-			ApiClient api = manager.GetApiClient();
-			if (api)
-				api.EnqueueEntityState(state.AsPayload());
+			if (playerControlled)
+				continue;
+
+			if (!found)
+			{
+				found = new OpsTrack_TrackedEntity(0, OpsTrack_EntityType.AI);
+				found.Attach(controlled);
+				record.members.Insert(found);
+			}
+
+			found.isAlive = !found.controller || !found.controller.IsDead();
+		}
+	}
+
+	// Full detail state for one AI member
+	protected void CaptureAiMember(OpsTrack_TrackedEntity member, OpsTrackManager manager, OpsTrack_EntityManager entityMgr, ApiClient api, int tick)
+	{
+		if (member.entityId.IsNull())
+		{
+			entityMgr.GetOrCreateAiEntity(member);
+			if (!member.entityId.IsNull() && manager.IsRecording() && api)
+				api.EnqueueEntityAssignment(member.entityIdStr);
 		}
 
-		// After capturing all positions, check if it's time to flush
-		ApiClient api = manager.GetApiClient();
+		if (member.entityId.IsNull())
+			return;
+
+		vector pos = member.entity.GetOrigin();
+		vector angles = member.entity.GetYawPitchRoll();
+		float rotation = angles[0]; // Yaw
+
+		if (!m_Filter.ShouldEmit(member.deadReckoning, pos, rotation, member.isAlive, tick))
+			return;
+
+		OpsTrack_EntityState state = OpsTrack_StatePool.Get().Acquire(
+			member.entityId,
+			OpsTrack_MissionClock.NowMs(),
+			pos[0], pos[1], pos[2],
+			rotation,
+			member.isAlive
+		);
+		member.lastStateMs = state.timestamp;
+
 		if (api)
-			api.CheckAndFlush();
+			api.EnqueueEntityState(state);
+	}
+
+	// Any player within the detail distance of a sphere (radius 0 for a single position)
+	protected bool IsNearPlayer(vector pos, float radius)
+	{
+		float reach = Math.Sqrt(m_AiDetailDistanceSq) + radius;
+		float reachSq = reach * reach;
+		foreach (vector playerPos : m_PlayerPositions)
+		{
+			if (vector.DistanceSq(pos, playerPos) <= reachSq)
+				return true;
+		}
+		return false;
 	}
 
+	// Track seat changes of a character. Returns true while it sits in a tracked vehicle.
+	protected bool UpdateSeat(OpsTrack_TrackedEntity record, OpsTrack_EntityManager entityMgr)
+	{
+		bool seated = record.compartmentAccess && record.compartmentAccess.IsInCompartment();
+
+		if (seated && !record.vehicle)
+		{
+			// Got in: find the vehicle (root of the compartment owner, e.g. for turrets)
+			BaseCompartmentSlot slot = record.compartmentAccess.GetCompartment();
+			if (slot && slot.GetOwner())
+			{
+				record.vehicle = entityMgr.TrackVehicle(slot.GetOwner().GetRootParent());
+				if (record.vehicle)
+				{
+					record.vehicle.crewDirty = true;
+					record.vehicle.nextSampleTick = 0;
+				}
+			}
+		}
+		else if (!seated && record.vehicle)
+		{
+			// Got out: the character's next position is always sent
+			LeaveVehicle(record);
+			record.deadReckoning = new OpsTrack_DeadReckoningTrack();
+		}
+
+		return record.vehicle != null;
+	}
+
+	// Take a character off its vehicle's crew (got out, or no longer tracked as this record)
+	protected void LeaveVehicle(OpsTrack_TrackedEntity record)
+	{
+		if (!record.vehicle)
+			return;
+
+		record.vehicle.crewDirty = true;
+		record.vehicle.nextSampleTick = 0;
+		record.vehicle = null;
+	}
+
+	// Queue the vehicle's current seat assignments
+	// Occupants that have no OpsTrack entity yet (not captured since they got in) get one first
+	protected void SendCrew(OpsTrack_TrackedEntity record, OpsTrackManager manager, OpsTrack_EntityManager entityMgr, ApiClient api)
+	{
+		record.crewDirty = false;
+		record.occupants = 0;
+
+		OpsTrack_CrewAssignment crew = new OpsTrack_CrewAssignment(record.entityId, OpsTrack_MissionClock.NowMs());
+		if (record.compartments)
+		{
+			array<BaseCompartmentSlot> slots = {};
+			record.compartments.GetCompartments(slots);
+			for (int seat = 0; seat < slots.Count(); seat++)
+			{
+				IEntity occupant = slots[seat].GetOccupant();
+				if (!occupant)
+					continue;
+
+				OpsTrack_TrackedEntity occupantRecord = entityMgr.FindOccupantRecord(occupant);
+				if (!occupantRecord)
+					continue;
+
+				if (occupantRecord.entityId.IsNull())
+				{
+					if (occupantRecord.playerId > 0)
+					{
+						EnsurePlayerEntity(occupantRecord, manager, entityMgr, api);
+					}
+					else
+					{
+						entityMgr.GetOrCreateAiEntity(occupantRecord);
+						if (!occupantRecord.entityId.IsNull() && manager.IsRecording() && api)
+							api.EnqueueEntityAssignment(occupantRecord.entityIdStr);
+					}
+				}
+
+				if (occupantRecord.entityIdStr == "")
+					continue;
+
+				crew.AddOccupant(occupantRecord.entityIdStr, seat);
+				record.occupants++;
+			}
+		}
+
+		if (api)
+			api.EnqueueCrewAssignment(crew);
+	}
 }
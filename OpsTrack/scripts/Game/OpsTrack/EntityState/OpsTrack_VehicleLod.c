@@ -0,0 +1,28 @@
+// OpsTrack_VehicleLod.c
+// Sampling interval for vehicles by speed and occupancy
+// Moving aircraft and fast vehicles are captured every cycle, crewed vehicles every few seconds,
+// and parked empty vehicles only occasionally. The dead-band filter still applies on top.
+
+class OpsTrack_VehicleLod
+{
+	private static const float FAST_SPEED = 8.0;        // m/s (~30 km/h)
+	private static const float MOVING_SPEED = 1.0;      // m/s - below this a vehicle counts as parked
+	private static const int FAST_INTERVAL_MS = 0;      // Every capture cycle
+	private static const int CREWED_INTERVAL_MS = 3000;
+	private static const int ROLLING_INTERVAL_MS = 2000; // Empty but moving (rolling down a hill, towed)
+	private static const int PARKED_INTERVAL_MS = 30000;
+
+	static int GetSampleIntervalMs(float speed, bool occupied, bool isAircraft)
+	{
+		if (speed >= FAST_SPEED || (isAircraft && speed >= MOVING_SPEED))
+			return FAST_INTERVAL_MS;
+
+		if (occupied)
+			return CREWED_INTERVAL_MS;
+
+		if (speed >= MOVING_SPEED)
+			return ROLLING_INTERVAL_MS;
+
+		return PARKED_INTERVAL_MS;
+	}
+}
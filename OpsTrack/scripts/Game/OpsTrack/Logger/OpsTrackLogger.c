@@ -79,6 +79,13 @@ class OpsTrackLogger
 		}
 	}
 
+	// Lets hot paths skip building debug messages that would be discarded
+	static bool IsDebugEnabled()
+	{
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		return manager && manager.GetSettings() && manager.GetSettings().EnableDebug;
+	}
+
 	// --- Convenience wrappers ---
 	static void Debug(string msg) { Log(OpsTrackLogLevel.DEBUG, msg); }
 	static void Info(string msg)  { Log(OpsTrackLogLevel.INFO, msg); }
@@ -4,10 +4,30 @@
 class OpsTrackCallback : RestCallback
 {
 	protected ApiClient m_Client;
+	protected OpsTrack_RequestKind m_Kind;
+	protected string m_Payload;        // Batch body, kept so a failed batch can be journaled
+	protected int m_BatchSeq;          // /batch sequence number (0 for non-batch requests)
+	protected int m_SentTick;          // For round-trip measurement
+	protected int m_RoundTripMs;
+	protected bool m_Succeeded;        // 2xx response (4xx also completes, but without success)
+	protected string m_ResponseData;   // Body of a successful response
+	protected int m_StringCount;       // String table entries the payload made known to the API
+	protected int m_StringGeneration;  // String table generation the entries belong to
+	protected int m_Attempt;           // 1 for the first send of a batch, counts up on retries
 
-	void OpsTrackCallback(ApiClient client)
+	void OpsTrackCallback(ApiClient client, OpsTrack_RequestKind kind = OpsTrack_RequestKind.MISSION, string payload = "", int batchSeq = 0)
 	{
 		m_Client = client;
+		m_Kind = kind;
+		m_Payload = payload;
+		m_BatchSeq = batchSeq;
+		m_SentTick = System.GetTickCount();
+		m_RoundTripMs = 0;
+		m_Succeeded = false;
+		m_ResponseData = "";
+		m_StringCount = 0;
+		m_StringGeneration = 0;
+		m_Attempt = 1;
 		
 		// Register callback functions
 		SetOnSuccess(OnSuccessHandler);
@@ -26,8 +46,14 @@ class OpsTrackCallback : RestCallback
 
 		int httpCode = cb.GetHttpCode();
 		string data = cb.GetData();
+		m_RoundTripMs = System.GetTickCount() - m_SentTick;
+		m_Succeeded = true;
+		m_ResponseData = data;
 
-		OpsTrackLogger.Info(string.Format("REST request succeeded. HTTP %1", httpCode));
+		if (m_BatchSeq > 0)
+			OpsTrackLogger.Info(string.Format("REST request succeeded. HTTP %1 (batch %2, %3 ms)", httpCode, m_BatchSeq, m_RoundTripMs));
+		else
+			OpsTrackLogger.Info(string.Format("REST request succeeded. HTTP %1", httpCode));
 
 		if (data && data != "")
 			OpsTrackLogger.Debug(string.Format("REST response: %1", data));
@@ -49,8 +75,9 @@ class OpsTrackCallback : RestCallback
 		int httpCode = cb.GetHttpCode();
 		string data = cb.GetData();
 		ERestResult restResult = cb.GetRestResult();
+		m_RoundTripMs = System.GetTickCount() - m_SentTick;
 
-		OpsTrackLogger.Error(string.Format("REST request failed. HTTP %1, RestResult %2", httpCode, restResult));
+		OpsTrackLogger.Error(string.Format("REST request failed. HTTP %1, RestResult %2, batch %3", httpCode, restResult, m_BatchSeq));
 
 		if (data && data != "")
 		{
@@ -67,9 +94,10 @@ class OpsTrackCallback : RestCallback
 			OpsTrackLogger.Error("Request timed out");
 		}
 
-		// Only trigger backoff for server errors (5xx) or connection issues
-		// Don't backoff for client errors like 400, 404 - these are data issues, not API issues
-		if (httpCode >= 500 || httpCode == 0 || restResult == ERestResult.EREST_ERROR_TIMEOUT)
+		// Only trigger backoff (and a retry of the batch) for server errors (5xx), connection issues,
+		// request timeouts (408) and rate limiting (429)
+		// Don't backoff for other client errors like 400, 404 - these are data issues, not API issues
+		if (httpCode >= 500 || httpCode == 0 || httpCode == 408 || httpCode == 429 || restResult == ERestResult.EREST_ERROR_TIMEOUT)
 		{
 			TriggerBackoff();
 		}
@@ -81,10 +109,78 @@ class OpsTrackCallback : RestCallback
 		}
 	}
 	
+	string GetPayload()
+	{
+		return m_Payload;
+	}
+
+	OpsTrack_RequestKind GetKind()
+	{
+		return m_Kind;
+	}
+
+	// Batch came from the journal and must be acknowledged there
+	bool IsJournalReplay()
+	{
+		return m_Kind == OpsTrack_RequestKind.JOURNAL_BATCH;
+	}
+
+	bool IsProbe()
+	{
+		return m_Kind == OpsTrack_RequestKind.PROBE;
+	}
+
+	int GetBatchSeq()
+	{
+		return m_BatchSeq;
+	}
+
+	void SetAttempt(int attempt)
+	{
+		m_Attempt = attempt;
+	}
+
+	int GetAttempt()
+	{
+		return m_Attempt;
+	}
+
+	void SetStringCount(int count, int generation)
+	{
+		m_StringCount = count;
+		m_StringGeneration = generation;
+	}
+
+	int GetStringCount()
+	{
+		return m_StringCount;
+	}
+
+	int GetStringGeneration()
+	{
+		return m_StringGeneration;
+	}
+
+	bool Succeeded()
+	{
+		return m_Succeeded;
+	}
+
+	string GetResponseData()
+	{
+		return m_ResponseData;
+	}
+
+	// Time from request creation to response (0 until a response arrived)
+	int GetRoundTripMs()
+	{
+		return m_RoundTripMs;
+	}
+
 	protected void TriggerBackoff()
 	{
 		if (m_Client)
-			m_Client.Backoff();
+			m_Client.Backoff(this);
 		else
 			OpsTrackLogger.Warn("Cannot trigger backoff: ApiClient reference is null");
 	}
@@ -92,6 +188,6 @@ class OpsTrackCallback : RestCallback
 	protected void NotifyComplete()
 	{
 		if (m_Client)
-			m_Client.OnRequestComplete();
+			m_Client.OnRequestComplete(this);
 	}
 }
@@ -109,18 +109,30 @@ class OpsTrackManager
 			return;
 		}
 
+		// Send what was stamped on the session clock before the mission clock takes over
+		// (still as mission-less batches)
+		if (m_ApiClient)
+			m_ApiClient.ForceFlush();
+
 		// Generate mission ID
 		m_CurrentMissionId = UUID.GenV4();
 		m_CurrentMissionName = missionName;
 		m_IsRecording = true;
 
-		// Send mission to API
-		string payload = string.Format(
-			"{\"missionId\":\"%1\",\"name\":\"%2\",\"mapName\":\"%3\"}",
-			m_CurrentMissionId,
-			missionName,
-			mapName
-		);
+		// All state and event times are ms relative to this point
+		OpsTrack_MissionClock.Start();
+		OpsTrack_EntityUtils.ResetCache();
+
+		// Send mission to API (with the UTC anchor of mission time 0)
+		// Name and map come from admin console input - escaped by the writer
+		OpsTrack_JsonWriter json = new OpsTrack_JsonWriter();
+		json.BeginObject();
+		json.WriteId("missionId", string.Format("%1", m_CurrentMissionId));
+		json.WriteString("name", missionName);
+		json.WriteString("mapName", mapName);
+		json.WriteId("startedAtUtc", OpsTrack_MissionClock.GetAnchorUtc());
+		json.EndObject();
+		string payload = json.Finish();
 
 		if (m_ApiClient)
 			m_ApiClient.SendMissionStart(payload);
@@ -170,6 +182,11 @@ class OpsTrackManager
 			return;
 		}
 
+		// Pending wounded summaries go out with the final flush
+		CombatEventSender combatEvents = CombatEventSender.Get();
+		if (combatEvents)
+			combatEvents.FlushAllWounded();
+
 		// Stop position tracking first (flushes remaining states)
 		OpsTrack_StateTracker stateTracker = OpsTrack_StateTracker.Get();
 		if (stateTracker)
@@ -178,8 +195,12 @@ class OpsTrackManager
 		// Send end mission to API
 		if (m_ApiClient)
 			m_ApiClient.SendMissionEnd(m_CurrentMissionId);
+		OpsTrack_MissionClock.Stop();
 
 		OpsTrackLogger.Info(string.Format("Recording stopped: %1", m_CurrentMissionName));
+		OpsTrackLogger.Info(OpsTrack_EntityUtils.GetCacheReport());
+		if (OpsTrackLogger.IsDebugEnabled())
+			LogPoolReports();
 
 		m_IsRecording = false;
 		m_CurrentMissionId = UUID.NULL_UUID;
@@ -190,6 +211,22 @@ class OpsTrackManager
 			m_EntityManager.ClearCache();
 	}
 
+	// Allocations per subsystem this mission - a long op should show mostly reuse
+	protected void LogPoolReports()
+	{
+		LogPoolReport(OpsTrack_StatePool.Get());
+		LogPoolReport(OpsTrack_GroupStatePool.Get());
+		LogPoolReport(OpsTrack_CombatEventPool.Get());
+		LogPoolReport(OpsTrack_WoundedHitsPool.Get());
+	}
+
+	protected void LogPoolReport(OpsTrack_ObjectPool pool)
+	{
+		string report = pool.TakeReport();
+		if (report != "")
+			OpsTrackLogger.Debug(report);
+	}
+
 	// --- Settings ---
 
 	void Reload()
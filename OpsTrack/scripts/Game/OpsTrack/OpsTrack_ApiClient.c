@@ -1,52 +1,147 @@
 // OpsTrack_ApiClient.c
 // Batched REST API client with rate limiting and backoff
-// Designed to minimize HTTP requests by combining all data into unified batches
+// Designed to minimize HTTP requests by combining data into batches on two lanes:
+//   - event lane: combat and connection events, flushed within EventFlushIntervalMs
+//   - bulk lane: entities, assignments and states, paced by the flush scheduler
 
 class ApiClient
 {
 	protected RestContext m_Context;
 
-	// Unified data queues - all sent together in one request
-	protected ref array<string> m_ConnectionEvents;
-	protected ref array<string> m_CombatEvents;
-	protected ref array<string> m_Entities;
-	protected ref array<string> m_EntityStates;
-	protected ref array<string> m_EntityAssignments;  // entityIds to assign to current mission
+	// Event lane queues (typed records, serialized when the batch is built)
+	protected ref OpsTrack_RecordQueue m_ConnectionEvents;
+	protected ref OpsTrack_RecordQueue m_CombatEvents;
 
-	protected ref OpsTrackCallback m_PendingCallback;
+	// Bulk lane queues
+	protected ref OpsTrack_RecordQueue m_Entities;
+	protected ref OpsTrack_StateQueue m_EntityStates;  // Ring buffer - states are the bulk of the data
+	protected ref array<string> m_EntityAssignments;  // entityIds to assign to current mission
+	protected ref OpsTrack_RecordQueue m_CrewAssignments;  // Vehicle seat assignments (sent on crew change)
+	protected ref OpsTrack_RecordQueue m_GroupStates;      // AI group aggregate states
+
+	// Requests waiting for a response - each owns its callback so nothing gets overwritten
+	protected ref array<ref OpsTrackCallback> m_InFlight;
+	protected ref array<ref OpsTrackCallback> m_Finished;  // Released on the next flush, not inside their own handler
+	protected ref OpsTrack_PayloadWriter m_PayloadWriter;  // Reused for every batch
+	protected ref OpsTrack_JsonWriter m_Json;              // Records and states write through this into m_PayloadWriter
+	protected ref OpsTrack_Journal m_Journal;              // Spill/replay store (null if disabled)
+	protected ref array<ref OpsTrack_RetryBatch> m_Retries; // Failed batches waiting for another attempt (no journal)
+	protected ref OpsTrack_FlushScheduler m_Scheduler;     // Picks flush interval and batch size
+	protected ref OpsTrack_ColumnarStateWriter m_ColumnarWriter;
+	protected ref OpsTrack_DeltaStateWriter m_DeltaWriter;  // Keeps the last sent value per entity
+	protected ref OpsTrack_StringTable m_Strings;          // Names, factions and weapons sent once, referenced by id
+	protected int m_JournalStringCount;                    // Table entries already written into the current journal segment
 
 	protected int m_LastFlushTick;
-	protected bool m_ApiEnabled;
-	protected int m_NextRetryTick;
+	protected ref OpsTrack_CircuitBreaker m_Breaker;       // Decides when the API may be used
+	protected string m_ProbeEndpoint;                      // GET target for half-open probes
 	protected bool m_IsShuttingDown;
-	protected bool m_HasPendingRequest;  // Track if we're waiting for a response
+	protected bool m_PumpScheduled;
+	protected int m_NextBatchSeq;        // Monotonic /batch sequence number (sent as batchSeq)
+	protected string m_SessionId;        // batchId scope for batches sent outside a mission
+	protected int m_MaxInFlight;         // Concurrent bulk /batch window
+
+	// Event lane state
+	protected int m_EventIntervalMs;
+	protected int m_LastEventFlushTick;
+	protected bool m_EventFlushScheduled;
+
+	// Items included in the last built payload (set by BuildUnifiedPayload, used by ClearSentItems)
+	protected ref OpsTrack_BatchPacker m_Packer;
+	protected int m_BuiltEntities;
+	protected int m_BuiltAssignments;
+	protected int m_BuiltConnectionEvents;
+	protected int m_BuiltCombatEvents;
+	protected int m_BuiltCrewAssignments;
+	protected int m_BuiltGroupStates;
+	protected int m_BuiltStates;
+
+	// State encoding - columnar only once the API has confirmed it understands it
+	protected bool m_WantColumnarStates;                   // EnableColumnarStates setting
+	protected bool m_WantDeltaStates;                      // EnableDeltaStates setting
+	protected bool m_CapabilitiesKnown;                    // API answered the capabilities request
+	protected bool m_CapabilitiesRequested;                // Capabilities request in flight
+	protected bool m_ApiAcceptsColumnar;
+	protected bool m_ApiAcceptsDelta;
+	protected OpsTrack_StateEncoding m_StateEncoding;
+	protected bool m_WantStringTable;                      // EnableStringTable setting
+	protected bool m_ApiAcceptsStrings;
 
 	// Configuration - tuned to avoid Enfusion's request limits
 	// Enfusion has an internal limit on concurrent requests per host
-	// By sending only ONE request every few seconds, we stay well under the limit
-	private static const int FLUSH_INTERVAL_MS = 3000;   // Flush every 3 seconds
-	private static const int MAX_STATES_PER_BATCH = 500; // Max entity states per request (keeps payload under ~100KB)
-	private static const int COOLDOWN_MS = 120000;       // Backoff on error
+	// MAX_IN_FLIGHT_LIMIT is split: bulk window (MaxInFlightBatches, up to 2) + 1 event lane slot
+	// + 1 slot for mission start/end and probes
+	private static const int FLUSH_INTERVAL_MS = 3000;   // Flush every 3 seconds (fixed mode / journal pump)
+	private static const int MAX_STATES_PER_BATCH = 500; // Max entity states per request in fixed mode (keeps payload under ~100KB)
+	private static const string DEFAULT_PROBE_ENDPOINT = "/health";
+	private static const int DEFAULT_MAX_QUEUED_STATES = 5000; // State queue capacity until settings are read
+	private static const int MAX_QUEUED_CONNECTION_EVENTS = 256;
+	private static const int MAX_QUEUED_COMBAT_EVENTS = 4096;
+	private static const int MAX_QUEUED_ENTITIES = 4096;
+	private static const int MAX_QUEUED_CREW_ASSIGNMENTS = 1024;
+	private static const int MAX_QUEUED_GROUP_STATES = 2048;
+	private static const int MAX_IN_FLIGHT_LIMIT = 4;    // Hard ceiling on concurrent requests (all endpoints)
+	private static const string BATCH_SEQ_PREFIX = "{\"batchSeq\":";
+	private static const string STRINGS_BLOCK_PREFIX = ",\"strings\":{";  // Last block of a batch (BuildUnifiedPayload)
+	private static const int MAX_BATCH_ATTEMPTS = 4;           // Sends of one batch before it is dropped
+	private static const int MAX_RETRY_BATCHES = 8;            // Failed batches held in memory (up to MAX_PAYLOAD_BYTES each)
+	private static const int RETRY_BASE_DELAY_MS = 2000;       // Delay before the first resend, doubled per attempt
+	private static const int EVENT_LANE_MAX_IN_FLIGHT = 1;     // Reserved slot for the event lane
+	private static const int EVENT_LANE_MAX_BYTES = 200000;    // Event lane payload budget
+	private static const int DEFAULT_EVENT_INTERVAL_MS = 250;
+	private static const int EVENT_RETRY_MS = 100;             // Re-check delay when the event lane is busy
+	private static const string CAPABILITIES_ENDPOINT = "/capabilities";
+	private static const string COLUMNAR_CAPABILITY = "\"columnar\"";
+	private static const string DELTA_CAPABILITY = "\"delta\"";
+	private static const string STRINGS_CAPABILITY = "\"strings\"";
 
 	// Payload size limits (Enfusion max is 1MB, we stay well under)
-	private static const int MAX_PAYLOAD_BYTES = 800000; // 800KB safety limit
+	private static const int MAX_PAYLOAD_BYTES = 800000; // 800KB budget per batch, shared by all sections
+	private static const int STATE_BLOCK_SLACK_BYTES = 1024; // Margin when a columnar/delta block is rewritten smaller
 
 	void ApiClient()
 	{
 		OpsTrackLogger.Info("Initializing ApiClient (unified batch mode)");
 
 		m_LastFlushTick = System.GetTickCount();
-		m_ApiEnabled = true;
-		m_NextRetryTick = 0;
+		m_Breaker = new OpsTrack_CircuitBreaker();
+		m_ProbeEndpoint = DEFAULT_PROBE_ENDPOINT;
 		m_IsShuttingDown = false;
-		m_HasPendingRequest = false;
+		m_NextBatchSeq = 1;
+		m_SessionId = string.Format("%1", UUID.GenV4());
+		m_MaxInFlight = 1;
+		m_InFlight = new array<ref OpsTrackCallback>();
+		m_Retries = new array<ref OpsTrack_RetryBatch>();
+		m_Finished = new array<ref OpsTrackCallback>();
+		m_EventIntervalMs = DEFAULT_EVENT_INTERVAL_MS;
+		m_LastEventFlushTick = 0;
+		m_EventFlushScheduled = false;
+		m_WantColumnarStates = false;
+		m_WantDeltaStates = false;
+		m_CapabilitiesKnown = false;
+		m_CapabilitiesRequested = false;
+		m_ApiAcceptsColumnar = false;
+		m_ApiAcceptsDelta = false;
+		m_StateEncoding = OpsTrack_StateEncoding.ROW;
+		m_WantStringTable = false;
+		m_ApiAcceptsStrings = false;
+		m_Strings = new OpsTrack_StringTable();
+		m_JournalStringCount = 0;
 
 		// Initialize all queues
-		m_ConnectionEvents = new array<string>();
-		m_CombatEvents = new array<string>();
-		m_Entities = new array<string>();
-		m_EntityStates = new array<string>();
+		m_ConnectionEvents = new OpsTrack_RecordQueue(MAX_QUEUED_CONNECTION_EVENTS);
+		m_CombatEvents = new OpsTrack_RecordQueue(MAX_QUEUED_COMBAT_EVENTS);
+		m_Entities = new OpsTrack_RecordQueue(MAX_QUEUED_ENTITIES);
+		m_EntityStates = new OpsTrack_StateQueue(DEFAULT_MAX_QUEUED_STATES);
 		m_EntityAssignments = new array<string>();
+		m_CrewAssignments = new OpsTrack_RecordQueue(MAX_QUEUED_CREW_ASSIGNMENTS);
+		m_GroupStates = new OpsTrack_RecordQueue(MAX_QUEUED_GROUP_STATES);
+		m_PayloadWriter = new OpsTrack_PayloadWriter();
+		m_Json = new OpsTrack_JsonWriter(m_PayloadWriter);
+		m_Packer = new OpsTrack_BatchPacker();
+		m_ColumnarWriter = new OpsTrack_ColumnarStateWriter();
+		m_DeltaWriter = new OpsTrack_DeltaStateWriter();
+		m_Scheduler = new OpsTrack_FlushScheduler(FLUSH_INTERVAL_MS, MAX_STATES_PER_BATCH);
 
 		// Get settings
 		OpsTrackManager manager = OpsTrackManager.GetIfExists();
@@ -63,6 +158,18 @@ class ApiClient
 			return;
 		}
 
+		m_EntityStates.SetCapacity(settings.MaxQueuedStates);
+		SetMaxInFlight(settings.MaxInFlightBatches);
+		m_Scheduler.SetAdaptive(settings.EnableAdaptiveFlush);
+		m_ProbeEndpoint = settings.ProbeEndpoint;
+		m_EventIntervalMs = settings.EventFlushIntervalMs;
+		m_WantColumnarStates = settings.EnableColumnarStates;
+		m_WantDeltaStates = settings.EnableDeltaStates;
+		m_WantStringTable = settings.EnableStringTable;
+
+		if (settings.EnableJournal)
+			m_Journal = new OpsTrack_Journal(settings.MaxJournalMB * 1024 * 1024);
+
 		// Get REST API
 		if (!GetGame())
 		{
@@ -91,6 +198,12 @@ class ApiClient
 		// NOTE: We don't use CallLater for the timer anymore.
 		// Instead, CheckAndFlush() is called from StateTracker.CaptureAllPositions()
 		// which already runs on a 1-second timer during recording.
+		// Exception: a journal left over from a previous session is replayed right away.
+		if (m_Journal && m_Journal.HasPending())
+			SchedulePump();
+
+		if (WantsCapabilities())
+			RequestCapabilities();
 
 		OpsTrackLogger.Info("ApiClient initialized successfully");
 	}
@@ -100,66 +213,81 @@ class ApiClient
 		OpsTrackLogger.Info("ApiClient shutting down");
 		m_IsShuttingDown = true;
 
-		// Final flush of any pending data
-		if (GetTotalPendingCount() > 0)
+		if (GetGame() && GetGame().GetCallqueue())
 		{
-			OpsTrackLogger.Warn(string.Format("Final flush: %1 pending items", GetTotalPendingCount()));
-			FlushUnified();
+			GetGame().GetCallqueue().Remove(PumpRecovery);
+			GetGame().GetCallqueue().Remove(OnEventFlushTimer);
+			GetGame().GetCallqueue().Remove(ContinueReplay);
 		}
+
+		if (GetTotalPendingCount() == 0 && !HasRetries())
+			return;
+
+		// A request sent now would most likely never complete - keep the data on disk instead
+		if (m_Journal)
+		{
+			OpsTrackLogger.Warn(string.Format("Final flush: journaling %1 pending items", GetTotalPendingCount()));
+			SpillToJournal();
+			return;
+		}
+
+		OpsTrackLogger.Warn(string.Format("Final flush: %1 pending items, %2 batch(es) to retry", GetTotalPendingCount(), m_Retries.Count()));
+		SendRetries(true);
+		FlushUnified();
 	}
 
 	// ============================================
 	// PUBLIC QUEUE METHODS - Add data to queues
 	// ============================================
 
-	// Queue a combat or connection event
-	void Enqueue(string eventJson, OpsTrack_EventType eventType)
+	// Queue a combat or connection event - serialized when the batch is built
+	void Enqueue(OpsTrack_PayloadRecord eventRecord, OpsTrack_EventType eventType)
 	{
-		if (!CanSend() || !eventJson || eventJson == "")
+		if (!CanQueue() || !eventRecord)
 			return;
 
 		if (eventType == OpsTrack_EventType.SELF_HARM ||
 			eventType == OpsTrack_EventType.KILL ||
 			eventType == OpsTrack_EventType.WOUNDED)
 		{
-			if (m_CombatEvents)
-				m_CombatEvents.Insert(eventJson);
+			PushRecord(m_CombatEvents, eventRecord, "Combat event");
 		}
 		else if (eventType == OpsTrack_EventType.JOIN ||
 				 eventType == OpsTrack_EventType.LEAVE)
 		{
-			if (m_ConnectionEvents)
-				m_ConnectionEvents.Insert(eventJson);
+			PushRecord(m_ConnectionEvents, eventRecord, "Connection event");
 		}
+
+		// Events don't wait for the bulk cadence
+		RequestEventFlush();
 	}
 
 	// Queue an entity for creation
-	void EnqueueEntity(string entityJson)
+	void EnqueueEntity(OpsTrack_Entity entity)
 	{
-		if (!CanSend() || !entityJson || entityJson == "")
+		if (!CanQueue() || !entity)
 			return;
 
-		if (m_Entities)
-		{
-			m_Entities.Insert(entityJson);
-			OpsTrackLogger.Debug(string.Format("Entity queued. Queue size: %1", m_Entities.Count()));
-		}
+		PushRecord(m_Entities, entity, "Entity");
+		OpsTrackLogger.Debug(string.Format("Entity queued. Queue size: %1", m_Entities.Count()));
 	}
 
-	// Queue entity state (position update)
-	void EnqueueEntityState(string stateJson)
+	// Queue entity state (position update) - serialized when the batch is built
+	void EnqueueEntityState(OpsTrack_EntityState state)
 	{
-		if (!CanSend() || !stateJson || stateJson == "")
+		if (!CanQueue() || !state)
 			return;
 
 		if (m_EntityStates)
 		{
-			m_EntityStates.Insert(stateJson);
+			if (!m_EntityStates.Push(state))
+				OpsTrackLogger.Debug(string.Format("State queue full (%1), oldest state dropped", m_EntityStates.GetCapacity()));
 
 			// Force flush if we have too many states (prevents payload from getting too large)
-			if (m_EntityStates.Count() >= MAX_STATES_PER_BATCH)
+			int batchSize = m_Scheduler.GetBatchSize();
+			if (m_EntityStates.Count() >= batchSize && (CanSend() || m_Journal) && HasFreeSlot())
 			{
-				OpsTrackLogger.Info(string.Format("State batch full (%1), forcing flush", MAX_STATES_PER_BATCH));
+				OpsTrackLogger.Info(string.Format("State batch full (%1), forcing flush", batchSize));
 				FlushUnified();
 			}
 		}
@@ -168,13 +296,41 @@ class ApiClient
 	// Queue entity assignment to current mission
 	void EnqueueEntityAssignment(string entityId)
 	{
-		if (!CanSend() || !entityId || entityId == "")
+		if (!CanQueue() || !entityId || entityId == "")
 			return;
 
 		if (m_EntityAssignments)
 			m_EntityAssignments.Insert(entityId);
 	}
 
+	// Queue a vehicle crew assignment (seat -> occupant entity)
+	void EnqueueCrewAssignment(OpsTrack_CrewAssignment crew)
+	{
+		if (!CanQueue() || !crew)
+			return;
+
+		PushRecord(m_CrewAssignments, crew, "Crew assignment");
+	}
+
+	// Queue an AI group aggregate state
+	void EnqueueGroupState(OpsTrack_GroupState groupState)
+	{
+		if (!CanQueue() || !groupState)
+			return;
+
+		PushRecord(m_GroupStates, groupState, "Group state");
+	}
+
+	// Add a record to its ring; a full ring drops its oldest record
+	protected void PushRecord(OpsTrack_RecordQueue queue, OpsTrack_PayloadRecord record, string label)
+	{
+		if (!queue)
+			return;
+
+		if (!queue.Push(record))
+			OpsTrackLogger.Warn(string.Format("%1 queue full (%2), oldest record dropped", label, queue.GetCapacity()));
+	}
+
 	// ============================================
 	// DIRECT SEND METHODS - For critical one-off requests
 	// These should be used sparingly!
@@ -183,23 +339,32 @@ class ApiClient
 	// Send mission start (must be sent immediately, not batched)
 	void SendMissionStart(string payload)
 	{
+		// Delta tracks and their statistics are per mission
+		m_DeltaWriter.ResetMission();
+
+		// The API keeps the string table per mission - the new mission starts an empty one
+		m_Strings.Clear();
+		m_JournalStringCount = 0;
+
 		if (!CanSend() || !m_Context)
 			return;
 
 		OpsTrackLogger.Info(string.Format("Sending mission start: %1", payload));
-		m_PendingCallback = new OpsTrackCallback(this);
-		m_Context.POST(m_PendingCallback, "/missions", payload);
+		m_Context.POST(TrackRequest(new OpsTrackCallback(this)), "/missions", payload);
 	}
 
 	// Send mission end (must be sent immediately)
 	void SendMissionEnd(UUID missionId)
 	{
+		if (m_DeltaWriter.HasStats())
+			OpsTrackLogger.Info(m_DeltaWriter.GetReport());
+		m_DeltaWriter.ResetMission();
+
 		if (!CanSend() || !m_Context)
 			return;
 
 		string endpoint = string.Format("/missions/%1/end", missionId);
-		m_PendingCallback = new OpsTrackCallback(this);
-		m_Context.POST(m_PendingCallback, endpoint, "{}");
+		m_Context.POST(TrackRequest(new OpsTrackCallback(this)), endpoint, "{}");
 	}
 
 	// ============================================
@@ -233,20 +398,42 @@ class ApiClient
 		if (m_IsShuttingDown)
 			return;
 
-		// Skip if we're still waiting for previous request
-		if (m_HasPendingRequest)
+		m_Finished.Clear();
+
+		// Circuit open: nothing goes out except the half-open probe
+		if (m_Breaker.TryStartProbe())
+			SendProbe();
+
+		// Failed batches go out again before any new data
+		SendRetries();
+
+		// Skip if the request window is full
+		if (!HasFreeSlot())
 		{
-			OpsTrackLogger.Debug("Skipping flush - previous request still pending");
+			OpsTrackLogger.Debug(string.Format("Skipping flush - %1 request(s) still in flight", m_InFlight.Count()));
 			return;
 		}
 
+		// Let the scheduler pick interval and batch size from the current backlog
+		int stateDepth = 0;
+		if (m_EntityStates)
+			stateDepth = m_EntityStates.Count();
+		m_Scheduler.Update(stateDepth);
+		int batchSize = m_Scheduler.GetBatchSize();
+
 		// Check if enough time has passed since last flush
+		// A full batch of states waiting is sent right away to use the free window slots
 		int now = System.GetTickCount();
-		if (now - m_LastFlushTick < FLUSH_INTERVAL_MS)
+		bool hasFullBatch = stateDepth >= batchSize;
+		if (now - m_LastFlushTick < m_Scheduler.GetIntervalMs() && !hasFullBatch)
 			return;
 
-		int total = GetTotalPendingCount();
-		if (total == 0)
+		// Safety net for the event lane timer
+		if (GetPendingEventCount() > 0)
+			RequestEventFlush();
+
+		int total = GetBulkPendingCount();
+		if (total == 0 && !HasJournalBacklog())
 			return;
 
 		// Log queue sizes
@@ -258,181 +445,713 @@ class ApiClient
 		if (m_EntityAssignments) assignCount = m_EntityAssignments.Count();
 
 		OpsTrackLogger.Info(string.Format("Unified flush: %1 states, %2 entities, %3 assignments", stateCount, entityCount, assignCount));
+		if (m_EntityStates)
+		{
+			OpsTrackLogger.Debug(string.Format("State queue: depth %1/%2, high-water %3, overflow %4",
+				m_EntityStates.Count(), m_EntityStates.GetCapacity(), m_EntityStates.GetHighWaterMark(), m_EntityStates.GetOverflowCount()));
+		}
+
+		// Fill the window: the first batch carries everything (and the next journal replay),
+		// further ones drain the state backlog
 		FlushUnified();
+		while (HasFreeSlot() && m_EntityStates && m_EntityStates.Count() >= m_Scheduler.GetBatchSize() && CanSend())
+		{
+			// Nothing went out (no REST context, data spilled) - the window won't change either
+			if (!FlushUnified())
+				break;
+		}
 	}
 
 	// Force flush - used when stopping recording
 	void ForceFlush()
 	{
-		if (GetTotalPendingCount() > 0)
+		if (GetTotalPendingCount() > 0 || HasJournalBacklog() || HasRetries())
 		{
 			OpsTrackLogger.Info("Force flushing remaining data...");
-			FlushUnified();
+			SendRetries(true);
+			FlushEvents(true);
+			FlushUnified(true);
+
+			// Whatever didn't fit in the request limit waits in the journal
+			if (GetTotalPendingCount() > 0 && m_Journal)
+				SpillToJournal();
 		}
 	}
 
-	// Send all queued data in a single request
-	protected void FlushUnified()
+	// Send queued bulk data (entities, states, assignments) in a single request
+	// Returns true if a batch was posted
+	protected bool FlushUnified(bool force = false)
 	{
-		if (GetTotalPendingCount() == 0)
-			return;
+		// While the API is down new data goes to the journal
+		if (m_Journal && !CanSend())
+		{
+			SpillToJournal();
+			return false;
+		}
+
+		// Journal replay runs next to live data - it takes one window slot, the rest stay live
+		if (HasJournalBacklog())
+			SendNextJournalBatch();
+
+		if (GetBulkPendingCount() == 0 || !CanSend())
+			return false;
+
+		if (!HasFreeSlot(force))
+		{
+			OpsTrackLogger.Debug("Flush deferred - request window full");
+			return false;
+		}
 
 		if (!m_Context)
 		{
 			OpsTrackLogger.Error("Cannot flush: REST context is null");
-			return;
+			return false;
 		}
 
 		// Limit states per batch to avoid payload size issues
-		int statesToSend = MAX_STATES_PER_BATCH;
+		int statesToSend = m_Scheduler.GetBatchSize();
 		if (m_EntityStates && m_EntityStates.Count() < statesToSend)
 			statesToSend = m_EntityStates.Count();
 
-		// Build unified payload (with limited states)
-		string payload = BuildUnifiedPayload(statesToSend);
-
-		// Check payload size
-		int payloadSize = payload.Length();
-		if (payloadSize > MAX_PAYLOAD_BYTES)
-		{
-			OpsTrackLogger.Warn(string.Format("Payload too large (%1 bytes), reducing batch size", payloadSize));
-			// Retry with smaller batch
-			statesToSend = statesToSend / 2;
-			if (statesToSend < 10)
-				statesToSend = 10;
-			payload = BuildUnifiedPayload(statesToSend);
-		}
+		// Build unified payload - whatever doesn't fit in the byte budget stays queued for the next batch
+		int batchSeq = m_NextBatchSeq;
+		m_NextBatchSeq++;
+		string payload = BuildUnifiedPayload(statesToSend, batchSeq, true, false, MAX_PAYLOAD_BYTES, GetLiveStringBase());
+		int statesSent = m_BuiltStates;
 
 		// Remove sent items from queues
-		ClearSentItems(statesToSend);
+		ClearSentItems();
+		m_Scheduler.OnBatchSent(statesSent, payload.Length());
 
 		m_LastFlushTick = System.GetTickCount();
-		m_HasPendingRequest = true;
 
-		// Send single unified request
-		m_PendingCallback = new OpsTrackCallback(this);
-		m_Context.POST(m_PendingCallback, "/batch", payload);
+		// Send unified request with its own callback
+		OpsTrackCallback callback = new OpsTrackCallback(this, OpsTrack_RequestKind.BATCH, payload, batchSeq);
+		callback.SetStringCount(m_Strings.Count(), m_Strings.GetGeneration());
+		m_Context.POST(TrackRequest(callback), "/batch", payload);
+		OpsTrackLogger.Debug(string.Format("Batch %1 sent (%2 bytes, %3/%4 in flight)", batchSeq, payload.Length(), m_InFlight.Count(), m_MaxInFlight));
 
 		// If there are remaining states, schedule another flush soon
 		if (m_EntityStates && m_EntityStates.Count() > 0)
 		{
 			OpsTrackLogger.Info(string.Format("Batch sent, %1 states remaining in queue", m_EntityStates.Count()));
 		}
+
+		return true;
 	}
 
-	// Build payload with a limit on how many states to include
-	protected string BuildUnifiedPayload(int maxStates)
+	// Build one /batch payload within byteBudget, filling the sections by priority:
+	// entities and assignments first (everything else refers to them), then events, crew, groups, states
+	// Uses the chunked writer so the cost stays linear in payload size; every item is written once,
+	// one that doesn't fit is cut off again and waits for the next batch with everything after it
+	// batchSeq is written first so it can be read back from journaled payloads cheaply
+	// batchId ("<missionId>-<batchSeq>") stays the same on every resend so the API can drop duplicates
+	// Batches without a mission carry sessionStartedAtUtc, the anchor of their session-relative times
+	// includeBulk: entities, assignments, crew, groups and states (up to maxStates)
+	// includeEvents: connection and combat events
+	// stringBase: first string table entry to include (-1 = no string table)
+	// Sets m_Built* to the number of items taken from each queue
+	protected string BuildUnifiedPayload(int maxStates, int batchSeq, bool includeBulk, bool includeEvents, int byteBudget, int stringBase)
 	{
 		OpsTrackManager manager = OpsTrackManager.GetIfExists();
 		string missionIdStr = "null";
+		string batchScope = m_SessionId;
 		if (manager && manager.IsRecording())
 		{
 			UUID missionId = manager.GetCurrentMissionId();
 			if (!missionId.IsNull())
-				missionIdStr = "\"" + missionId + "\"";
+			{
+				batchScope = string.Format("%1", missionId);
+				missionIdStr = "\"" + batchScope + "\"";
+			}
 		}
 
-		string payload = "{";
-		payload = payload + "\"missionId\":" + missionIdStr + ",";
+		// Delta values of a previous build that was never sent (e.g. a failed journal write) must not be committed
+		m_DeltaWriter.Discard();
 
-		// Entities array (all entities - these are small)
-		payload = payload + "\"entities\":[";
-		if (m_Entities)
+		OpsTrack_PayloadWriter writer = m_PayloadWriter;
+		writer.Reset();
+
+		writer.Append("{\"batchSeq\":");
+		writer.Append(batchSeq.ToString());
+		writer.Append(",\"batchId\":");
+		writer.AppendQuoted(batchScope + "-" + batchSeq.ToString());
+		writer.Append(",\"missionId\":");
+		writer.Append(missionIdStr);
+		writer.Append(",");
+
+		// Times outside a mission are on the session clock
+		if (missionIdStr == "null")
 		{
-			for (int i = 0; i < m_Entities.Count(); i++)
-			{
-				payload = payload + m_Entities[i];
-				if (i < m_Entities.Count() - 1)
-					payload = payload + ",";
-			}
+			writer.Append("\"sessionStartedAtUtc\":");
+			writer.AppendQuoted(OpsTrack_MissionClock.GetSessionAnchorUtc());
+			writer.Append(",");
 		}
-		payload = payload + "],";
 
-		// Entity states array (limited to maxStates)
-		payload = payload + "\"states\":[";
-		if (m_EntityStates)
+		OpsTrack_StringTable strings = null;
+		if (stringBase >= 0)
+			strings = m_Strings;
+		m_Packer.Begin(writer, byteBudget, strings, stringBase);
+
+		int bulkItems = 0;
+		if (includeBulk)
+			bulkItems = -1;
+		int eventItems = 0;
+		if (includeEvents)
+			eventItems = -1;
+
+		m_BuiltEntities = WriteRecords(writer, "entities", m_Entities, bulkItems, strings);
+		writer.Append(",");
+		m_BuiltAssignments = WriteArray(writer, "assignEntityIds", m_EntityAssignments, bulkItems);
+		writer.Append(",");
+
+		// Connection events are rare and go before combat events
+		m_BuiltConnectionEvents = WriteRecords(writer, "connectionEvents", m_ConnectionEvents, eventItems, null);
+		writer.Append(",");
+		m_BuiltCombatEvents = WriteRecords(writer, "combatEvents", m_CombatEvents, eventItems, strings);
+		writer.Append(",");
+
+		// Crew assignments (only sent when a vehicle's crew changes)
+		m_BuiltCrewAssignments = WriteRecords(writer, "crewAssignments", m_CrewAssignments, bulkItems, null);
+		writer.Append(",");
+
+		// AI group aggregates (members in full detail are regular states)
+		m_BuiltGroupStates = WriteRecords(writer, "groupStates", m_GroupStates, bulkItems, null);
+		writer.Append(",");
+
+		// Entity states (up to maxStates, then whatever the remaining budget holds)
+		int stateCount = 0;
+		if (m_EntityStates && includeBulk)
 		{
-			int stateCount = m_EntityStates.Count();
+			stateCount = m_EntityStates.Count();
 			if (stateCount > maxStates)
 				stateCount = maxStates;
+		}
+		m_BuiltStates = WriteStates(writer, stateCount);
+
+		// Dictionary entries last - the records above intern their strings while being written.
+		// Key order doesn't matter to the API, it resolves references after parsing the whole batch.
+		if (stringBase >= 0 && m_Strings.HasEntriesFrom(stringBase))
+		{
+			writer.Append(",");
+			m_Strings.Write(writer, stringBase);
+		}
+		writer.Append("}");
+
+		if (m_Packer.IsFull())
+		{
+			OpsTrackLogger.Debug(string.Format("Batch %1 reached its %2 byte budget, %3 items carried over",
+				batchSeq, byteBudget, GetTotalPendingCount() - GetBuiltCount()));
+		}
+
+		return writer.Finish();
+	}
+
+	// Items taken from the queues by the last BuildUnifiedPayload
+	protected int GetBuiltCount()
+	{
+		return m_BuiltEntities + m_BuiltAssignments + m_BuiltConnectionEvents + m_BuiltCombatEvents
+			+ m_BuiltCrewAssignments + m_BuiltGroupStates + m_BuiltStates;
+	}
+
+	// Write "key":["id",...] and return how many items were written (maxItems < 0 = as many as fit)
+	protected int WriteArray(OpsTrack_PayloadWriter writer, string key, array<string> items, int maxItems)
+	{
+		writer.Append("\"" + key + "\":[");
 
-			for (int s = 0; s < stateCount; s++)
+		int written = 0;
+		if (items)
+		{
+			int count = items.Count();
+			if (maxItems >= 0 && count > maxItems)
+				count = maxItems;
+
+			for (int i = 0; i < count && m_Packer.HasRoom(); i++)
 			{
-				payload = payload + m_EntityStates[s];
-				if (s < stateCount - 1)
-					payload = payload + ",";
+				int mark = writer.Length();
+				if (i > 0)
+					writer.Append(",");
+				writer.AppendQuoted(items[i]);
+
+				if (!m_Packer.Accept(mark))
+					break;
+				written++;
 			}
 		}
-		payload = payload + "],";
 
-		// Entity assignments array (all - these are small)
-		payload = payload + "\"assignEntityIds\":[";
-		if (m_EntityAssignments)
+		writer.Append("]");
+		return written;
+	}
+
+	// Write "key":[record,...] straight into the payload and return how many records were written
+	// (maxItems < 0 = as many as fit)
+	protected int WriteRecords(OpsTrack_PayloadWriter writer, string key, OpsTrack_RecordQueue records, int maxItems, OpsTrack_StringTable strings)
+	{
+		writer.Append("\"" + key + "\":[");
+
+		int written = 0;
+		if (records)
 		{
-			for (int a = 0; a < m_EntityAssignments.Count(); a++)
+			int count = records.Count();
+			if (maxItems >= 0 && count > maxItems)
+				count = maxItems;
+
+			for (int i = 0; i < count && m_Packer.HasRoom(); i++)
 			{
-				payload = payload + "\"" + m_EntityAssignments[a] + "\"";
-				if (a < m_EntityAssignments.Count() - 1)
-					payload = payload + ",";
+				int mark = writer.Length();
+				if (i > 0)
+					writer.Append(",");
+				records.Get(i).Write(m_Json, strings);
+
+				if (!m_Packer.Accept(mark))
+					break;
+				written++;
 			}
 		}
-		payload = payload + "],";
 
-		// Connection events array (all - these are rare)
-		payload = payload + "\"connectionEvents\":[";
-		if (m_ConnectionEvents)
+		writer.Append("]");
+		return written;
+	}
+
+	// Write the oldest count states in the current encoding and return how many made it in
+	// Row states are packed one by one; a columnar or delta block that doesn't fit is rewritten
+	// with the share of states that does (estimated from the block's own size)
+	protected int WriteStates(OpsTrack_PayloadWriter writer, int count)
+	{
+		if (!m_Packer.HasRoom())
+			count = 0;
+
+		if (m_StateEncoding == OpsTrack_StateEncoding.ROW || count == 0)
 		{
-			for (int c = 0; c < m_ConnectionEvents.Count(); c++)
+			writer.Append("\"states\":[");
+			int written = 0;
+			for (int s = 0; s < count && m_Packer.HasRoom(); s++)
 			{
-				payload = payload + m_ConnectionEvents[c];
-				if (c < m_ConnectionEvents.Count() - 1)
-					payload = payload + ",";
+				int mark = writer.Length();
+				if (s > 0)
+					writer.Append(",");
+				m_EntityStates.Get(s).Write(m_Json);
+
+				if (!m_Packer.Accept(mark))
+					break;
+				written++;
 			}
+			writer.Append("]");
+			return written;
 		}
-		payload = payload + "],";
 
-		// Combat events array
-		payload = payload + "\"combatEvents\":[";
-		if (m_CombatEvents)
+		int blockMark = writer.Length();
+		while (count > 0)
 		{
-			for (int cb = 0; cb < m_CombatEvents.Count(); cb++)
+			WriteStateBlock(writer, count);
+			if (m_Packer.GetRoom() >= 0)
+				return count;
+
+			// Rewrite with the share that fits (sizes aren't exactly proportional, so aim a little lower)
+			float blockBytes = writer.Length() - blockMark;
+			m_Packer.Rollback(blockMark);
+			float share = (m_Packer.GetRoom() - STATE_BLOCK_SLACK_BYTES) / blockBytes;
+			int fit = count * share;
+			if (fit >= count)
+				fit = count - 1;
+			count = fit;
+		}
+
+		// Not a single state fits - an empty block also resets the delta writer's pending tracks
+		WriteStateBlock(writer, 0);
+		m_Packer.Close();
+		return 0;
+	}
+
+	// "states" stays in the document (empty) so the batch shape is the same for all encodings
+	protected void WriteStateBlock(OpsTrack_PayloadWriter writer, int count)
+	{
+		writer.Append("\"states\":[],");
+		if (m_StateEncoding == OpsTrack_StateEncoding.DELTA)
+			m_DeltaWriter.Write(writer, m_EntityStates, count);
+		else
+			m_ColumnarWriter.Write(writer, m_EntityStates, count);
+	}
+
+	// ============================================
+	// EVENT LANE - Low-latency combat/connection events
+	// ============================================
+
+	// Flush events now if the lane interval has passed, otherwise schedule a flush for when it does
+	protected void RequestEventFlush()
+	{
+		if (m_IsShuttingDown || m_EventFlushScheduled || GetPendingEventCount() == 0)
+			return;
+
+		int wait = m_EventIntervalMs - (System.GetTickCount() - m_LastEventFlushTick);
+		if (wait <= 0 && FlushEvents())
+			return;
+
+		if (wait < EVENT_RETRY_MS)
+			wait = EVENT_RETRY_MS;
+
+		if (GetGame() && GetGame().GetCallqueue())
+		{
+			GetGame().GetCallqueue().CallLater(OnEventFlushTimer, wait, false);
+			m_EventFlushScheduled = true;
+		}
+	}
+
+	protected void OnEventFlushTimer()
+	{
+		m_EventFlushScheduled = false;
+		m_Finished.Clear();
+		RequestEventFlush();
+	}
+
+	// Send queued events on their own small batch, independent of the state backlog
+	// Returns false if the events have to wait (lane busy or API unavailable without a journal)
+	protected bool FlushEvents(bool force = false)
+	{
+		if (GetPendingEventCount() == 0)
+			return true;
+
+		// Same rule as the bulk lane: events go to the journal only while the API is down
+		if (m_Journal && !CanSend())
+		{
+			SpillToJournal();
+			return true;
+		}
+
+		if (!CanSend() || !m_Context || !HasEventSlot(force))
+			return false;
+
+		int batchSeq = m_NextBatchSeq;
+		m_NextBatchSeq++;
+		string payload = BuildUnifiedPayload(0, batchSeq, false, true, EVENT_LANE_MAX_BYTES, GetLiveStringBase());
+		int connectionCount = m_BuiltConnectionEvents;
+		int combatCount = m_BuiltCombatEvents;
+		ClearSentItems();
+
+		m_LastEventFlushTick = System.GetTickCount();
+
+		OpsTrackCallback callback = new OpsTrackCallback(this, OpsTrack_RequestKind.EVENT_BATCH, payload, batchSeq);
+		callback.SetStringCount(m_Strings.Count(), m_Strings.GetGeneration());
+		m_Context.POST(TrackRequest(callback), "/batch", payload);
+		OpsTrackLogger.Debug(string.Format("Event batch %1 sent (%2 connection, %3 combat, %4 bytes)", batchSeq, connectionCount, combatCount, payload.Length()));
+
+		// Anything over the byte budget goes in the next event batch
+		if (GetPendingEventCount() > 0)
+			RequestEventFlush();
+
+		return true;
+	}
+
+	// ============================================
+	// JOURNAL - Spill and replay
+	// ============================================
+
+	protected bool HasJournalBacklog()
+	{
+		return m_Journal && m_Journal.HasPending();
+	}
+
+	// Move everything queued in memory to the journal as ready-to-send batches
+	protected void SpillToJournal()
+	{
+		if (!m_Journal)
+			return;
+
+		// Batches waiting for a retry (journal enabled since they failed) go first to keep the order
+		int batches = 0;
+		while (m_Retries.Count() > 0)
+		{
+			if (!AppendFailedBatch(m_Retries[0]))
 			{
-				payload = payload + m_CombatEvents[cb];
-				if (cb < m_CombatEvents.Count() - 1)
-					payload = payload + ",";
+				OpsTrackLogger.Error("Journal write failed - keeping data in memory");
+				return;
 			}
+
+			m_Retries.RemoveOrdered(0);
+			batches++;
 		}
-		payload = payload + "]";
 
-		payload = payload + "}";
+		while (GetTotalPendingCount() > 0)
+		{
+			// Every segment starts with the full string table, later batches of the segment add to it -
+			// a segment dropped for the disk budget takes no definitions the others need
+			if (m_Journal.StartsNewSegment())
+				m_JournalStringCount = 0;
+
+			int statesToSend = m_Scheduler.GetBatchSize();
+			if (m_EntityStates && m_EntityStates.Count() < statesToSend)
+				statesToSend = m_EntityStates.Count();
+
+			int stringBase = -1;
+			if (GetStringTable())
+				stringBase = m_JournalStringCount;
+
+			string payload = BuildUnifiedPayload(statesToSend, m_NextBatchSeq, true, true, MAX_PAYLOAD_BYTES, stringBase);
+			if (!AppendToJournal(payload))
+			{
+				OpsTrackLogger.Error("Journal write failed - keeping data in memory");
+				return;
+			}
 
-		return payload;
+			if (stringBase >= 0)
+				m_JournalStringCount = m_Strings.Count();
+			ClearSentItems();
+			m_NextBatchSeq++;
+			batches++;
+		}
+
+		if (batches > 0)
+			OpsTrackLogger.Info(string.Format("Spilled %1 batch(es) to journal (%2 segment(s) pending)", batches, m_Journal.GetPendingSegments()));
 	}
 
-	// Clear only the items that were sent (states are limited, others are cleared fully)
-	protected void ClearSentItems(int statesSent)
+	// Append one batch - a segment dropped for the disk budget took delta base values with it,
+	// so every chain restarts from a keyframe
+	protected bool AppendToJournal(string payload)
 	{
-		// Clear all non-state queues (they're always sent in full)
-		if (m_ConnectionEvents)
-			m_ConnectionEvents.Clear();
-		if (m_CombatEvents)
-			m_CombatEvents.Clear();
-		if (m_Entities)
-			m_Entities.Clear();
-		if (m_EntityAssignments)
-			m_EntityAssignments.Clear();
+		if (!m_Journal.Append(payload))
+			return false;
+
+		if (m_Journal.TakeSegmentDrop())
+		{
+			OpsTrackLogger.Warn("Journal dropped its oldest segment - restarting delta chains from keyframes");
+			m_DeltaWriter.ForceKeyframes();
+		}
+		return true;
+	}
+
+	// Send the oldest journaled batch
+	// Replay stays strictly sequential (one journal batch in flight) so segments are acknowledged in order;
+	// each acknowledgement sends the next one right away (ContinueReplay)
+	protected void SendNextJournalBatch()
+	{
+		if (!m_Journal || !m_Context || !CanSend() || !HasFreeSlot())
+			return;
+
+		foreach (OpsTrackCallback pending : m_InFlight)
+		{
+			if (pending.IsJournalReplay())
+				return;
+		}
+
+		string payload = m_Journal.PeekBatch();
+		if (payload == "")
+			return;
+
+		m_LastFlushTick = System.GetTickCount();
+
+		m_Context.POST(TrackRequest(new OpsTrackCallback(this, OpsTrack_RequestKind.JOURNAL_BATCH, payload, ParseBatchSeq(payload))), "/batch", payload);
+
+		OpsTrackLogger.Debug(string.Format("Replaying journaled batch (%1 segment(s) pending)", m_Journal.GetPendingSegments()));
+	}
+
+	// ============================================
+	// RETRIES - Failed batches without a journal
+	// ============================================
+
+	protected bool HasRetries()
+	{
+		return m_Retries && m_Retries.Count() > 0;
+	}
+
+	// Hold a failed batch for another attempt - dropped once it has had MAX_BATCH_ATTEMPTS
+	// Batches sent after it may already carry deltas on top of its values (the API orders chains by
+	// batchSeq), so a drop restarts every chain from a keyframe
+	protected void QueueRetry(OpsTrackCallback callback)
+	{
+		int attempt = callback.GetAttempt();
+		if (attempt >= MAX_BATCH_ATTEMPTS)
+		{
+			OpsTrackLogger.Error(string.Format("Batch %1 dropped after %2 attempts", callback.GetBatchSeq(), attempt));
+			m_DeltaWriter.ForceKeyframes();
+			return;
+		}
+
+		if (m_Retries.Count() >= MAX_RETRY_BATCHES)
+		{
+			OpsTrackLogger.Error(string.Format("Retry table full - batch %1 dropped", m_Retries[0].batchSeq));
+			m_Retries.RemoveOrdered(0);
+			m_DeltaWriter.ForceKeyframes();
+		}
 
-		// Remove only the states that were sent (first N items)
-		if (m_EntityStates && statesSent > 0)
+		int delayMs = RETRY_BASE_DELAY_MS;
+		for (int i = 1; i < attempt; i++)
 		{
-			// Remove from front of array
-			for (int i = 0; i < statesSent && m_EntityStates.Count() > 0; i++)
+			delayMs *= 2;
+		}
+
+		m_Retries.Insert(CopyFailedBatch(callback, delayMs));
+		OpsTrackLogger.Warn(string.Format("Batch %1 failed (attempt %2/%3), retrying in %4 ms", callback.GetBatchSeq(), attempt, MAX_BATCH_ATTEMPTS, delayMs));
+	}
+
+	// Copy of a failed batch that doesn't depend on earlier batches for its strings: the string block is
+	// replaced by entries [0, n) of the table. The API may have lost the table by the time it's resent,
+	// and the journal can't rely on a base that was acknowledged live.
+	protected OpsTrack_RetryBatch CopyFailedBatch(OpsTrackCallback callback, int delayMs)
+	{
+		OpsTrack_RetryBatch copy = new OpsTrack_RetryBatch(callback, delayMs);
+
+		int count = callback.GetStringCount();
+		int generation = callback.GetStringGeneration();
+		if (!GetStringTable() || count <= 0 || generation != m_Strings.GetGeneration())
+			return copy;
+
+		// No block when the API already knew every entry - then only the closing brace is cut
+		int blockStart = copy.payload.LastIndexOf(STRINGS_BLOCK_PREFIX);
+		if (blockStart < 0)
+			blockStart = copy.payload.Length() - 1;
+
+		m_PayloadWriter.Reset();
+		m_PayloadWriter.Append(copy.payload.Substring(0, blockStart));
+		m_PayloadWriter.Append(",");
+		m_Strings.Write(m_PayloadWriter, 0, count);
+		m_PayloadWriter.Append("}");
+
+		copy.payload = m_PayloadWriter.Finish();
+		copy.stringCount = count;
+		copy.stringGeneration = generation;
+		return copy;
+	}
+
+	// Journal a failed batch (a CopyFailedBatch copy) - later spilled batches add to the strings it carries
+	protected bool AppendFailedBatch(OpsTrack_RetryBatch failed)
+	{
+		bool newSegment = m_Journal.StartsNewSegment();
+		if (!AppendToJournal(failed.payload))
+			return false;
+
+		int carried = 0;
+		if (failed.stringGeneration == m_Strings.GetGeneration())
+			carried = failed.stringCount;
+
+		if (newSegment || carried > m_JournalStringCount)
+			m_JournalStringCount = carried;
+		return true;
+	}
+
+	// Resend failed batches that are due, oldest first, in the lane they were sent on
+	// force: ignore the retry delay (final flush)
+	protected void SendRetries(bool force = false)
+	{
+		if (!HasRetries() || !m_Context || !CanSend())
+			return;
+
+		int now = System.GetTickCount();
+		int i = 0;
+		while (i < m_Retries.Count())
+		{
+			OpsTrack_RetryBatch retry = m_Retries[i];
+
+			bool hasSlot;
+			if (retry.kind == OpsTrack_RequestKind.EVENT_BATCH)
+				hasSlot = HasEventSlot(force);
+			else
+				hasSlot = HasFreeSlot(force);
+
+			if (!hasSlot || (!force && now - retry.dueTick < 0))
 			{
-				m_EntityStates.Remove(0);
+				i++;
+				continue;
 			}
+
+			OpsTrackCallback callback = new OpsTrackCallback(this, retry.kind, retry.payload, retry.batchSeq);
+			callback.SetAttempt(retry.attempts + 1);
+			callback.SetStringCount(retry.stringCount, retry.stringGeneration);
+			m_Context.POST(TrackRequest(callback), "/batch", retry.payload);
+			OpsTrackLogger.Debug(string.Format("Batch %1 resent (attempt %2/%3, %4 bytes)", retry.batchSeq, retry.attempts + 1, MAX_BATCH_ATTEMPTS, retry.payload.Length()));
+
+			m_Retries.RemoveOrdered(i);
 		}
 	}
 
+	// Next replay after an acknowledged one (deferred out of the callback handler)
+	protected void ContinueReplay()
+	{
+		if (m_IsShuttingDown)
+			return;
+
+		m_Finished.Clear();
+		if (HasJournalBacklog())
+			SendNextJournalBatch();
+	}
+
+	// Recovery driver for when CheckAndFlush isn't being called (not recording):
+	// replays the journal and sends circuit breaker probes
+	protected void SchedulePump()
+	{
+		if (m_PumpScheduled)
+			return;
+
+		if (GetGame() && GetGame().GetCallqueue())
+		{
+			GetGame().GetCallqueue().CallLater(PumpRecovery, FLUSH_INTERVAL_MS, false);
+			m_PumpScheduled = true;
+		}
+	}
+
+	protected void PumpRecovery()
+	{
+		m_PumpScheduled = false;
+
+		if (m_IsShuttingDown || (!HasJournalBacklog() && !HasRetries() && m_Breaker.IsClosed()))
+			return;
+
+		OpsTrackManager manager = OpsTrackManager.GetIfExists();
+		if (!manager || !manager.IsRecording())
+			CheckAndFlush();
+
+		SchedulePump();
+	}
+
+	// Clear only the items that were sent in the last built payload (the oldest N of every queue)
+	// Whatever the byte budget or batch size left out stays in front for the next batch
+	protected void ClearSentItems()
+	{
+		if (m_Entities)
+			m_Entities.Drop(m_BuiltEntities);
+		DropFront(m_EntityAssignments, m_BuiltAssignments);
+		if (m_ConnectionEvents)
+			m_ConnectionEvents.Drop(m_BuiltConnectionEvents);
+		if (m_CombatEvents)
+			m_CombatEvents.Drop(m_BuiltCombatEvents);
+		if (m_CrewAssignments)
+			m_CrewAssignments.Drop(m_BuiltCrewAssignments);
+		if (m_GroupStates)
+			m_GroupStates.Drop(m_BuiltGroupStates);
+		if (m_EntityStates)
+			m_EntityStates.Drop(m_BuiltStates);
+
+		m_BuiltEntities = 0;
+		m_BuiltAssignments = 0;
+		m_BuiltConnectionEvents = 0;
+		m_BuiltCombatEvents = 0;
+		m_BuiltCrewAssignments = 0;
+		m_BuiltGroupStates = 0;
+		m_BuiltStates = 0;
+
+		// The payload is final - its delta values become the base for the next batch
+		m_DeltaWriter.Commit();
+	}
+
+	// Remove the oldest count items, keeping the order of the rest
+	protected void DropFront(array<string> items, int count)
+	{
+		if (!items || count <= 0)
+			return;
+
+		if (count >= items.Count())
+		{
+			items.Clear();
+			return;
+		}
+
+		int remaining = items.Count() - count;
+		for (int i = 0; i < remaining; i++)
+		{
+			items[i] = items[i + count];
+		}
+		items.Resize(remaining);
+	}
+
 	protected void ClearAllQueues()
 	{
 		if (m_ConnectionEvents)
@@ -445,58 +1164,378 @@ class ApiClient
 			m_EntityStates.Clear();
 		if (m_EntityAssignments)
 			m_EntityAssignments.Clear();
+		if (m_CrewAssignments)
+			m_CrewAssignments.Clear();
+		if (m_GroupStates)
+			m_GroupStates.Clear();
 	}
 
 	// ============================================
 	// HELPER METHODS
 	// ============================================
 
+	// Data is still accepted during backoff when the journal can hold it
+	protected bool CanQueue()
+	{
+		if (m_Journal)
+			return true;
+		return CanSend();
+	}
+
+	// Only a closed circuit sends - reopening is decided by the probe, not by a timestamp
 	protected bool CanSend()
 	{
-		if (!m_ApiEnabled)
-		{
-			int now = System.GetTickCount();
-			if (now < m_NextRetryTick)
-				return false;
+		return m_Breaker.IsClosed();
+	}
 
-			m_ApiEnabled = true;
-			OpsTrackLogger.Info("API re-enabled after cooldown");
-		}
-		return true;
+	// Lightweight health check sent while the circuit is half-open
+	protected void SendProbe()
+	{
+		if (!m_Context)
+			return;
+
+		OpsTrackLogger.Debug(string.Format("Sending API probe: GET %1", m_ProbeEndpoint));
+		m_Context.GET(TrackRequest(new OpsTrackCallback(this, OpsTrack_RequestKind.PROBE)), m_ProbeEndpoint);
+	}
+
+	// Flush right away after a successful probe instead of waiting for the next interval
+	protected void ResumeAfterProbe()
+	{
+		m_LastFlushTick = 0;
+
+		// The API may have restarted and lost the string table
+		m_Strings.ResendAll();
+
+		// Live batches go out next to the journal replay - restart their delta chains
+		// so they don't build on values that are still on disk
+		if (HasJournalBacklog())
+			m_DeltaWriter.ForceKeyframes();
+
+		// Capabilities request failed while the API was down - ask again
+		if (WantsCapabilities() && !m_CapabilitiesKnown)
+			RequestCapabilities();
+
+		CheckAndFlush();
+	}
+
+	// ============================================
+	// STATE ENCODING NEGOTIATION
+	// ============================================
+
+	// Ask the API which state encodings it accepts (GET /capabilities -> {"stateEncodings":["row","columnar","delta"]})
+	// Until it answers, states are sent as rows
+	protected void RequestCapabilities()
+	{
+		if (!m_Context || m_CapabilitiesRequested || !CanSend())
+			return;
+
+		m_CapabilitiesRequested = true;
+		OpsTrackLogger.Debug(string.Format("Requesting API capabilities: GET %1", CAPABILITIES_ENDPOINT));
+		m_Context.GET(TrackRequest(new OpsTrackCallback(this, OpsTrack_RequestKind.CAPABILITIES)), CAPABILITIES_ENDPOINT);
+	}
+
+	protected void OnCapabilities(OpsTrackCallback callback)
+	{
+		m_CapabilitiesRequested = false;
+		m_CapabilitiesKnown = true;
+
+		// Older APIs answer 404 - they only understand rows
+		string data = callback.GetResponseData();
+		m_ApiAcceptsColumnar = callback.Succeeded() && data.Contains(COLUMNAR_CAPABILITY);
+		m_ApiAcceptsDelta = callback.Succeeded() && data.Contains(DELTA_CAPABILITY);
+		m_ApiAcceptsStrings = callback.Succeeded() && data.Contains(STRINGS_CAPABILITY);
+		if (m_WantDeltaStates && !m_ApiAcceptsDelta)
+			OpsTrackLogger.Info("API does not accept delta states");
+		if (m_WantColumnarStates && !m_ApiAcceptsColumnar)
+			OpsTrackLogger.Info("API does not accept columnar states");
+		if (m_WantStringTable && !m_ApiAcceptsStrings)
+			OpsTrackLogger.Info("API does not accept a string table");
+		else if (m_WantStringTable)
+			OpsTrackLogger.Info("String table enabled");
+
+		UpdateStateEncoding();
+	}
+
+	// Each encoding needs both its setting and the API's confirmation; delta wins over columnar
+	protected void UpdateStateEncoding()
+	{
+		OpsTrack_StateEncoding encoding = OpsTrack_StateEncoding.ROW;
+		if (m_WantDeltaStates && m_ApiAcceptsDelta)
+			encoding = OpsTrack_StateEncoding.DELTA;
+		else if (m_WantColumnarStates && m_ApiAcceptsColumnar)
+			encoding = OpsTrack_StateEncoding.COLUMNAR;
+
+		if (encoding == m_StateEncoding)
+			return;
+
+		// Switching to delta starts every entity with a keyframe
+		if (encoding == OpsTrack_StateEncoding.DELTA)
+			m_DeltaWriter.ForceKeyframes();
+
+		m_StateEncoding = encoding;
+		if (encoding == OpsTrack_StateEncoding.DELTA)
+			OpsTrackLogger.Info("State encoding: quantized delta");
+		else if (encoding == OpsTrack_StateEncoding.COLUMNAR)
+			OpsTrackLogger.Info("State encoding: columnar");
+		else
+			OpsTrackLogger.Info("State encoding: row");
+	}
+
+	OpsTrack_StateEncoding GetStateEncoding()
+	{
+		return m_StateEncoding;
+	}
+
+	// String table for payload producers (null = write strings inline)
+	OpsTrack_StringTable GetStringTable()
+	{
+		if (m_WantStringTable && m_ApiAcceptsStrings)
+			return m_Strings;
+		return null;
+	}
+
+	// Unacknowledged entries go in every live batch (-1 when the table is not in use)
+	protected int GetLiveStringBase()
+	{
+		if (!GetStringTable())
+			return -1;
+		return m_Strings.GetAckedCount();
+	}
+
+	protected bool WantsCapabilities()
+	{
+		return m_WantColumnarStates || m_WantDeltaStates || m_WantStringTable;
 	}
 
 	int GetTotalPendingCount()
+	{
+		return GetPendingEventCount() + GetBulkPendingCount();
+	}
+
+	// Combat and connection events waiting for the event lane
+	int GetPendingEventCount()
 	{
 		int count = 0;
 		if (m_ConnectionEvents)
 			count = count + m_ConnectionEvents.Count();
 		if (m_CombatEvents)
 			count = count + m_CombatEvents.Count();
+		return count;
+	}
+
+	// Entities, states and assignments waiting for the bulk lane
+	int GetBulkPendingCount()
+	{
+		int count = 0;
 		if (m_Entities)
 			count = count + m_Entities.Count();
 		if (m_EntityStates)
 			count = count + m_EntityStates.Count();
 		if (m_EntityAssignments)
 			count = count + m_EntityAssignments.Count();
+		if (m_CrewAssignments)
+			count = count + m_CrewAssignments.Count();
+		if (m_GroupStates)
+			count = count + m_GroupStates.Count();
+		return count;
+	}
+
+	// State queue diagnostics (depth, high-water mark, overflow)
+	OpsTrack_StateQueue GetStateQueue()
+	{
+		return m_EntityStates;
+	}
+
+	// Apply settings that can change at runtime
+	void ApplySettings(OpsTrackSettings settings)
+	{
+		if (!settings || !m_EntityStates)
+			return;
+
+		if (m_Journal)
+			m_Journal.SetMaxBytes(settings.MaxJournalMB * 1024 * 1024);
+
+		m_ProbeEndpoint = settings.ProbeEndpoint;
+		m_EventIntervalMs = settings.EventFlushIntervalMs;
+		SetMaxInFlight(settings.MaxInFlightBatches);
+		m_Scheduler.SetAdaptive(settings.EnableAdaptiveFlush);
+
+		m_WantColumnarStates = settings.EnableColumnarStates;
+		m_WantDeltaStates = settings.EnableDeltaStates;
+		m_WantStringTable = settings.EnableStringTable;
+		UpdateStateEncoding();
+		if (WantsCapabilities() && !m_CapabilitiesKnown)
+			RequestCapabilities();
+
+		if (settings.MaxQueuedStates != m_EntityStates.GetCapacity())
+		{
+			m_EntityStates.SetCapacity(settings.MaxQueuedStates);
+			OpsTrackLogger.Info(string.Format("State queue capacity set to %1", settings.MaxQueuedStates));
+		}
+	}
+
+	// ============================================
+	// REQUEST WINDOW
+	// ============================================
+
+	// Register a request as in flight and return its callback for the POST
+	protected OpsTrackCallback TrackRequest(OpsTrackCallback callback)
+	{
+		m_InFlight.Insert(callback);
+		return callback;
+	}
+
+	// Move a completed request out of the window
+	protected void ReleaseRequest(OpsTrackCallback callback)
+	{
+		int index = m_InFlight.Find(callback);
+		if (index < 0)
+			return;
+
+		// Keep it alive until the next flush - we're still inside its handler
+		m_Finished.Insert(callback);
+		m_InFlight.Remove(index);
+	}
+
+	// Bulk lane slot: bulk and journal batches count against the MaxInFlightBatches window
+	// force = use the whole per-host limit (final flush when recording stops)
+	protected bool HasFreeSlot(bool force = false)
+	{
+		if (force)
+			return m_InFlight.Count() < MAX_IN_FLIGHT_LIMIT;
+
+		return CountInFlight(OpsTrack_RequestKind.BATCH) + CountInFlight(OpsTrack_RequestKind.JOURNAL_BATCH) < m_MaxInFlight;
+	}
+
+	// Event lane slot: reserved, so a deep state backlog never delays kills and joins
+	protected bool HasEventSlot(bool force = false)
+	{
+		if (force)
+			return m_InFlight.Count() < MAX_IN_FLIGHT_LIMIT;
+
+		return CountInFlight(OpsTrack_RequestKind.EVENT_BATCH) < EVENT_LANE_MAX_IN_FLIGHT;
+	}
+
+	protected int CountInFlight(OpsTrack_RequestKind kind)
+	{
+		int count = 0;
+		foreach (OpsTrackCallback pending : m_InFlight)
+		{
+			if (pending.GetKind() == kind)
+				count++;
+		}
 		return count;
 	}
 
+	int GetInFlightCount()
+	{
+		return m_InFlight.Count();
+	}
+
+	protected void SetMaxInFlight(int maxInFlight)
+	{
+		// Leave the event lane slot and one slot for mission start/end and probes
+		m_MaxInFlight = Math.ClampInt(maxInFlight, 1, MAX_IN_FLIGHT_LIMIT - EVENT_LANE_MAX_IN_FLIGHT - 1);
+	}
+
+	// Read the batchSeq back from a payload built by BuildUnifiedPayload ({"batchSeq":N,...)
+	protected static int ParseBatchSeq(string payload)
+	{
+		if (!payload.StartsWith(BATCH_SEQ_PREFIX))
+			return 0;
+
+		int start = BATCH_SEQ_PREFIX.Length();
+		int comma = payload.IndexOf(",");
+		if (comma <= start)
+			return 0;
+
+		return payload.Substring(start, comma - start).ToInt();
+	}
+
 	// Called when request completes successfully
-	void OnRequestComplete()
+	void OnRequestComplete(OpsTrackCallback callback)
 	{
-		m_HasPendingRequest = false;
+		ReleaseRequest(callback);
+
+		if (callback && callback.GetKind() == OpsTrack_RequestKind.CAPABILITIES)
+			OnCapabilities(callback);
+
+		// Any answer from the API (even 4xx) proves it's reachable
+		if (callback && callback.IsProbe())
+		{
+			m_Breaker.OnSuccess();
+			if (GetGame() && GetGame().GetCallqueue())
+				GetGame().GetCallqueue().CallLater(ResumeAfterProbe, 0, false);
+			return;
+		}
+
+		// Successful traffic resets the failure streak (late successes don't close an open circuit)
+		if (m_Breaker.IsClosed())
+			m_Breaker.OnSuccess();
+
+		// Only bulk batches feed the scheduler - small event batches would skew its latency average
+		if (callback && callback.GetBatchSeq() > 0 && callback.GetKind() != OpsTrack_RequestKind.EVENT_BATCH)
+			m_Scheduler.OnBatchAcked(callback.GetRoundTripMs());
+
+		if (callback && callback.IsJournalReplay() && m_Journal)
+		{
+			m_Journal.AckBatch();
+
+			// Replay done - live batches start over with the full string table
+			if (!m_Journal.HasPending())
+			{
+				m_Strings.ResendAll();
+				m_JournalStringCount = 0;
+			}
+			else if (GetGame() && GetGame().GetCallqueue())
+			{
+				GetGame().GetCallqueue().CallLater(ContinueReplay, 0, false);
+			}
+		}
+		else if (callback && callback.Succeeded())
+		{
+			m_Strings.Ack(callback.GetStringCount(), callback.GetStringGeneration());
+		}
+
+		// A rejected batch (4xx) never reaches the API - restart delta chains from keyframes
+		if (callback && !callback.Succeeded() && callback.GetBatchSeq() > 0 && callback.GetKind() != OpsTrack_RequestKind.EVENT_BATCH)
+			m_DeltaWriter.ForceKeyframes();
 	}
 
 	// Called by callback on error - triggers backoff
-	void Backoff()
+	void Backoff(OpsTrackCallback callback)
 	{
-		m_ApiEnabled = false;
-		m_HasPendingRequest = false;
-		m_NextRetryTick = System.GetTickCount() + COOLDOWN_MS;
+		ReleaseRequest(callback);
+
+		// Open the circuit (a failed probe re-opens it with a longer cooldown)
+		m_Breaker.OnFailure();
+		SchedulePump();
+
+		// Probes and capability requests carry no data (capabilities are asked again after the probe)
+		if (callback && callback.GetKind() == OpsTrack_RequestKind.CAPABILITIES)
+			m_CapabilitiesRequested = false;
+
+		if (callback && (callback.IsProbe() || callback.GetKind() == OpsTrack_RequestKind.CAPABILITIES))
+			return;
+
+		if (callback && callback.GetKind() != OpsTrack_RequestKind.EVENT_BATCH)
+			m_Scheduler.OnBatchFailed();
+
+		if (!m_Journal)
+		{
+			// The failed batch is kept for a bounded number of resends,
+			// pending data is dropped during backoff to prevent memory buildup
+			if (callback && callback.GetBatchSeq() > 0 && callback.GetPayload() != "")
+				QueueRetry(callback);
+			ClearAllQueues();
+			m_DeltaWriter.ForceKeyframes();
+			return;
+		}
 
-		OpsTrackLogger.Warn(string.Format("API backoff triggered. Will retry in %1 seconds.", COOLDOWN_MS / 1000));
+		// Keep the failed batch (replayed batches are still in the journal) and everything queued after it
+		if (callback && !callback.IsJournalReplay() && callback.GetPayload() != "")
+			AppendFailedBatch(CopyFailedBatch(callback, 0));
 
-		// Drop pending data during backoff to prevent memory buildup
-		ClearAllQueues();
+		SpillToJournal();
 	}
 }
@@ -1,7 +1,7 @@
 //OpsTrack_Entity.c
 //Data class for game entities (players, vehicles, AI)
 
-class OpsTrack_Entity
+class OpsTrack_Entity : OpsTrack_PayloadRecord
 {
 	UUID entityId;
 	string name;
@@ -18,27 +18,27 @@ class OpsTrack_Entity
 		this.playerId = playerId;
 	}
 	
-    string AsPayload()
+    // strings: the ApiClient's string table, null to write name and faction inline
+    // Note: missionId is sent at batch level, not per entity
+    override void Write(OpsTrack_JsonWriter json, OpsTrack_StringTable strings)
     {
-        // PlayerId - null eller string
-        string playerIdPart = "null";
-        if (playerId != "")
-            playerIdPart = "\"" + playerId + "\"";
+        json.BeginObject();
+        json.WriteId("entityId", string.Format("%1", entityId));
+        if (strings)
+            json.WriteInt("nameRef", strings.Intern(name));
+        else
+            json.WriteString("name", name);
+        json.WriteInt("type", type);
+        if (strings)
+            json.WriteInt("factionRef", strings.Intern(faction));
+        else
+            json.WriteString("faction", faction);
 
-        // Note: missionId is sent at batch level, not per entity
-        return string.Format(
-            "{" +
-                "\"entityId\":\"%1\"," +
-                "\"name\":\"%2\"," +
-                "\"type\":%3," +
-                "\"faction\":\"%4\"," +
-                "\"playerId\":%5" +
-            "}",
-            entityId,
-            name,
-            type,
-            faction,
-            playerIdPart
-        );
+        // PlayerId - null or string
+        if (playerId != "")
+            json.WriteId("playerId", playerId);
+        else
+            json.WriteNull("playerId");
+        json.EndObject();
     }
 }
\ No newline at end of file
@@ -7,10 +7,21 @@ class OpsTrack_EntityManager
 	
 	//Cache: sessionPlayerId -> entityId
 	private ref map<int, UUID> m_PlayerEntities;
+
+	//Registry: dense array of tracked entities (iterated by StateTracker) + player lookup
+	//Maintained from the game mode hooks (spawn, possession, death, disconnect)
+	private ref array<ref OpsTrack_TrackedEntity> m_Tracked;
+	private ref map<int, OpsTrack_TrackedEntity> m_TrackedPlayers;
+	private ref map<IEntity, OpsTrack_TrackedEntity> m_TrackedByEntity;  // Game entity -> record (FindRecord)
+
+	private static const int COMBAT_DETAIL_MS = 30000; // Full detail for AI members after damage dealt or taken
 	
     private void OpsTrack_EntityManager()
     {
         m_PlayerEntities = new map<int, UUID>();
+        m_Tracked = new array<ref OpsTrack_TrackedEntity>();
+        m_TrackedPlayers = new map<int, OpsTrack_TrackedEntity>();
+        m_TrackedByEntity = new map<IEntity, OpsTrack_TrackedEntity>();
     }
     
     static OpsTrack_EntityManager Get()
@@ -46,6 +57,10 @@ class OpsTrack_EntityManager
 
         // Save in cache
         m_PlayerEntities.Set(sessionPlayerId, entityId);
+
+        OpsTrack_TrackedEntity record = m_TrackedPlayers.Get(sessionPlayerId);
+        if (record)
+            record.SetEntityId(entityId);
         
         // Send til API
         SendEntityToApi(entity);
@@ -68,12 +83,312 @@ class OpsTrack_EntityManager
     }
     
     // clear cache (at server or mission restart for example)
+    // Tracked records stay (the players are still in game) but lose their entity ids
     void ClearCache()
     {
         m_PlayerEntities.Clear();
+        foreach (OpsTrack_TrackedEntity record : m_Tracked)
+        {
+            record.SetEntityId(UUID.NULL_UUID);
+            record.ResetState();
+        }
         OpsTrackLogger.Info("Entity cache cleared");
     }
 
+    // ============================================
+    // TRACKED ENTITY REGISTRY
+    // ============================================
+
+    // Player spawned or took control of an entity (spawn and possession hooks)
+    OpsTrack_TrackedEntity TrackPlayerEntity(int sessionPlayerId, IEntity entity)
+    {
+        if (sessionPlayerId <= 0 || !entity)
+            return null;
+
+        OpsTrack_TrackedEntity record = m_TrackedPlayers.Get(sessionPlayerId);
+        if (!record)
+        {
+            record = new OpsTrack_TrackedEntity(sessionPlayerId, OpsTrack_EntityType.PLAYER);
+            record.index = m_Tracked.Count();
+            m_Tracked.Insert(record);
+            m_TrackedPlayers.Set(sessionPlayerId, record);
+        }
+
+        AttachRecord(record, entity);
+        record.SetEntityId(GetEntityId(sessionPlayerId));
+
+        OpsTrackLogger.Debug(string.Format("Tracking player %1 (%2 tracked)", sessionPlayerId, m_Tracked.Count()));
+        return record;
+    }
+
+    // Player released control (possession ended without a new entity)
+    void DetachPlayerEntity(int sessionPlayerId)
+    {
+        OpsTrack_TrackedEntity record = m_TrackedPlayers.Get(sessionPlayerId);
+        if (record)
+            AttachRecord(record, null);
+    }
+
+    // Death hook: the record stays so the final (dead) state is still captured
+    void MarkDead(IEntity entity)
+    {
+        OpsTrack_TrackedEntity record = FindRecord(entity);
+        if (record)
+            record.isAlive = false;
+    }
+
+    // Disconnect hook: drop the record
+    void UntrackPlayer(int sessionPlayerId)
+    {
+        OpsTrack_TrackedEntity record = m_TrackedPlayers.Get(sessionPlayerId);
+        if (!record)
+            return;
+
+        m_TrackedPlayers.Remove(sessionPlayerId);
+
+        // Vehicle the player sat in needs new seat assignments
+        if (record.vehicle)
+            record.vehicle.crewDirty = true;
+
+        RemoveRecord(record);
+        OpsTrackLogger.Debug(string.Format("Stopped tracking player %1 (%2 tracked)", sessionPlayerId, m_Tracked.Count()));
+    }
+
+    // Vehicle spawned (Vehicle.EOnInit hook). The OpsTrack entity is created on first capture while recording.
+    OpsTrack_TrackedEntity TrackVehicle(IEntity vehicle)
+    {
+        if (!vehicle)
+            return null;
+
+        OpsTrack_TrackedEntity record = FindRecord(vehicle);
+        if (record)
+            return record;
+
+        record = new OpsTrack_TrackedEntity(0, OpsTrack_EntityType.VEHICLE);
+        record.index = m_Tracked.Count();
+        m_Tracked.Insert(record);
+        AttachRecord(record, vehicle);
+        return record;
+    }
+
+    // AI group spawned (SCR_AIGroup.EOnInit hook) - members are picked up from the group on capture
+    // Playable groups are player squads - their members are tracked as players already
+    OpsTrack_TrackedEntity TrackAiGroup(SCR_AIGroup group)
+    {
+        if (!group || group.IsPlayable())
+            return null;
+
+        OpsTrack_TrackedEntity record = FindRecord(group);
+        if (record)
+            return record;
+
+        record = new OpsTrack_TrackedEntity(0, OpsTrack_EntityType.AI);
+        record.group = group;
+        record.members = new array<ref OpsTrack_TrackedEntity>();
+        record.index = m_Tracked.Count();
+        m_Tracked.Insert(record);
+        AttachRecord(record, group);
+        return record;
+    }
+
+    // Damage hook: put an AI member into full detail for a while (no-op for players)
+    void MarkCombat(IEntity entity)
+    {
+        if (!entity)
+            return;
+
+        AIControlComponent control = AIControlComponent.Cast(entity.FindComponent(AIControlComponent));
+        if (!control)
+            return;
+
+        AIAgent agent = control.GetControlAIAgent();
+        if (!agent)
+            return;
+
+        OpsTrack_TrackedEntity member = FindAiMember(agent, entity);
+        if (member)
+            member.combatUntilTick = System.GetTickCount() + COMBAT_DETAIL_MS;
+    }
+
+    // Member record of an AI character (members live in their group's record, not the registry)
+    protected OpsTrack_TrackedEntity FindAiMember(AIAgent agent, IEntity entity)
+    {
+        OpsTrack_TrackedEntity groupRecord = FindRecord(agent.GetParentGroup());
+        if (!groupRecord || !groupRecord.members)
+            return null;
+
+        foreach (OpsTrack_TrackedEntity member : groupRecord.members)
+        {
+            if (member.entity == entity)
+                return member;
+        }
+        return null;
+    }
+
+    // Record of a vehicle occupant: a registry record (player) or an AI group member
+    OpsTrack_TrackedEntity FindOccupantRecord(IEntity occupant)
+    {
+        OpsTrack_TrackedEntity record = FindRecord(occupant);
+        if (record || !occupant)
+            return record;
+
+        AIControlComponent control = AIControlComponent.Cast(occupant.FindComponent(AIControlComponent));
+        if (!control || !control.GetControlAIAgent())
+            return null;
+
+        return FindAiMember(control.GetControlAIAgent(), occupant);
+    }
+
+    // Create and queue the OpsTrack entity for an AI group or member
+    UUID GetOrCreateAiEntity(OpsTrack_TrackedEntity record)
+    {
+        if (!record || !record.entity)
+            return UUID.NULL_UUID;
+
+        if (!record.entityId.IsNull())
+            return record.entityId;
+
+        string factionName = "Unknown";
+        Faction faction;
+        if (record.group)
+            faction = record.group.GetFaction();
+        else
+            faction = OpsTrack_EntityUtils.GetFaction(record.entity, 0);
+        if (faction)
+            factionName = faction.GetFactionName();
+
+        UUID entityId = UUID.GenV4();
+        OpsTrack_Entity entity = new OpsTrack_Entity(
+            entityId,
+            OpsTrack_EntityUtils.ResolveCharacterName(record.entity),
+            factionName,
+            "",
+            OpsTrack_EntityType.AI
+        );
+
+        record.SetEntityId(entityId);
+        SendEntityToApi(entity);
+        return entityId;
+    }
+
+    // Create and queue the OpsTrack entity for a tracked vehicle
+    UUID GetOrCreateVehicleEntity(OpsTrack_TrackedEntity record)
+    {
+        if (!record || !record.entity)
+            return UUID.NULL_UUID;
+
+        if (!record.entityId.IsNull())
+            return record.entityId;
+
+        string factionName = "Unknown";
+        Faction faction = OpsTrack_EntityUtils.GetFaction(record.entity, 0);
+        if (faction)
+            factionName = faction.GetFactionName();
+
+        UUID entityId = UUID.GenV4();
+        OpsTrack_Entity entity = new OpsTrack_Entity(
+            entityId,
+            OpsTrack_EntityUtils.ResolveCharacterName(record.entity),
+            factionName,
+            "",
+            OpsTrack_EntityType.VEHICLE
+        );
+
+        record.SetEntityId(entityId);
+        SendEntityToApi(entity);
+
+        OpsTrackLogger.Debug(string.Format("Created vehicle entity %1 (%2)", entityId, entity.name));
+        return entityId;
+    }
+
+    // Record of a tracked game entity
+    OpsTrack_TrackedEntity FindRecord(IEntity entity)
+    {
+        if (!entity)
+            return null;
+
+        OpsTrack_TrackedEntity record = m_TrackedByEntity.Get(entity);
+        if (record && record.entity == entity)
+            return record;
+
+        // Left behind by a deleted entity whose address was reused
+        if (m_TrackedByEntity.Contains(entity))
+            m_TrackedByEntity.Remove(entity);
+        return null;
+    }
+
+    // Point a registry record at a (new) game entity, keeping the lookup map in step
+    protected void AttachRecord(OpsTrack_TrackedEntity record, IEntity entity)
+    {
+        if (record.entity && m_TrackedByEntity.Get(record.entity) == record)
+            m_TrackedByEntity.Remove(record.entity);
+
+        record.Attach(entity);
+        if (entity)
+            m_TrackedByEntity.Set(entity, record);
+    }
+
+    // Swap-remove keeps the array dense
+    void RemoveRecord(OpsTrack_TrackedEntity record)
+    {
+        int index = record.index;
+        if (index < 0 || index >= m_Tracked.Count() || m_Tracked[index] != record)
+            return;
+
+        record.index = -1;
+        if (record.entity && m_TrackedByEntity.Get(record.entity) == record)
+            m_TrackedByEntity.Remove(record.entity);
+
+        int last = m_Tracked.Count() - 1;
+        if (index < last)
+        {
+            m_Tracked[index] = m_Tracked[last];
+            m_Tracked[index].index = index;
+        }
+        m_Tracked.Remove(last);
+    }
+
+    // Register players that are already in game (mod loaded mid-session, possession before recording)
+    // Runs once when tracking starts - the capture loop itself never enumerates players
+    void SyncTrackedPlayers()
+    {
+        PlayerManager playerMgr = GetGame().GetPlayerManager();
+        if (!playerMgr)
+            return;
+
+        array<int> playerIds = {};
+        playerMgr.GetPlayers(playerIds);
+        foreach (int playerId : playerIds)
+        {
+            IEntity controlled = playerMgr.GetPlayerControlledEntity(playerId);
+            if (!controlled)
+                continue;
+
+            OpsTrack_TrackedEntity record = m_TrackedPlayers.Get(playerId);
+            if (!record || record.entity != controlled)
+                TrackPlayerEntity(playerId, controlled);
+        }
+    }
+
+    // Forget emitted states of all records (new recording)
+    void ResetTrackedStates()
+    {
+        foreach (OpsTrack_TrackedEntity record : m_Tracked)
+        {
+            record.ResetState();
+        }
+    }
+
+    array<ref OpsTrack_TrackedEntity> GetTrackedEntities()
+    {
+        return m_Tracked;
+    }
+
+    OpsTrack_TrackedEntity GetTrackedPlayer(int sessionPlayerId)
+    {
+        return m_TrackedPlayers.Get(sessionPlayerId);
+    }
+
     // Get all cached entity IDs (for assigning to mission)
     array<UUID> GetAllEntityIds()
     {
@@ -102,8 +417,8 @@ class OpsTrack_EntityManager
             return;
         }
 
-        string payload = entity.AsPayload();
-        OpsTrackLogger.Debug(string.Format("Sending entity to API queue: %1", payload));
-        api.EnqueueEntity(payload);
+        if (OpsTrackLogger.IsDebugEnabled())
+            OpsTrackLogger.Debug(string.Format("Sending entity to API queue: %1", entity.AsPayload()));
+        api.EnqueueEntity(entity);
     }
 }
\ No newline at end of file
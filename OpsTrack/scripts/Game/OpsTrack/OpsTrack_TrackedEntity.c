@@ -0,0 +1,128 @@
+//OpsTrack_TrackedEntity.c
+//Registry record for an entity whose position is captured every tick
+
+class OpsTrack_TrackedEntity : Managed
+{
+	IEntity entity;                                  // Currently controlled/tracked game entity
+	SCR_CharacterControllerComponent controller;     // Cached at registration (null for non-characters)
+	OpsTrack_EntityType type;
+	int playerId;                                    // Session player id (0 if not a player)
+	UUID entityId;                                   // OpsTrack entity id (null until assigned)
+	string entityIdStr;                              // entityId formatted once
+	bool isAlive;                                    // Cleared by the death hook
+	int index;                                       // Position in the registry's dense array
+	int nextSampleTick;                              // Level of detail: skip captures until this tick
+
+	// Characters
+	CompartmentAccessComponent compartmentAccess;    // Cached at registration
+	OpsTrack_TrackedEntity vehicle;                  // Vehicle record the character sits in (null on foot)
+
+	// Vehicles
+	SCR_BaseCompartmentManagerComponent compartments; // Cached at registration
+	Physics physics;
+	bool isAircraft;
+	bool crewDirty;                                  // Crew changed - send seat assignments on next capture
+	int occupants;                                   // Seated crew at the last assignment
+
+	// AI groups (one registry record per group, members are owned by it)
+	SCR_AIGroup group;
+	ref array<ref OpsTrack_TrackedEntity> members;
+	int lastAliveCount;
+
+	// AI members
+	int combatUntilTick;                             // Full detail until this tick (damaged or dealt damage)
+
+	int lastStateMs;                                 // Mission time of the last state queued for upload (-1 = none)
+	ref OpsTrack_DeadReckoningTrack deadReckoning;   // Dead-band filter state
+
+	void OpsTrack_TrackedEntity(int sessionPlayerId, OpsTrack_EntityType entityType)
+	{
+		playerId = sessionPlayerId;
+		type = entityType;
+		entityId = UUID.NULL_UUID;
+		entityIdStr = "";
+		isAlive = true;
+		index = -1;
+		nextSampleTick = 0;
+		crewDirty = false;
+		occupants = 0;
+		isAircraft = false;
+		lastAliveCount = -1;
+		combatUntilTick = 0;
+		lastStateMs = -1;
+		deadReckoning = new OpsTrack_DeadReckoningTrack();
+	}
+
+	// Point the record at a (new) game entity and cache its component handles
+	void Attach(IEntity newEntity)
+	{
+		entity = newEntity;
+		controller = null;
+		compartmentAccess = null;
+		compartments = null;
+		physics = null;
+		vehicle = null;
+		isAlive = true;
+		nextSampleTick = 0;
+
+		if (entity)
+		{
+			controller = SCR_CharacterControllerComponent.Cast(entity.FindComponent(SCR_CharacterControllerComponent));
+			compartmentAccess = CompartmentAccessComponent.Cast(entity.FindComponent(CompartmentAccessComponent));
+			physics = entity.GetPhysics();
+
+			if (type == OpsTrack_EntityType.VEHICLE)
+			{
+				compartments = SCR_BaseCompartmentManagerComponent.Cast(entity.FindComponent(SCR_BaseCompartmentManagerComponent));
+				isAircraft = entity.FindComponent(HelicopterControllerComponent) != null;
+				crewDirty = true;
+			}
+		}
+
+		if (controller && controller.IsDead())
+			isAlive = false;
+	}
+
+	void SetEntityId(UUID id)
+	{
+		entityId = id;
+		entityIdStr = "";
+		if (!id.IsNull())
+			entityIdStr = string.Format("%1", id);
+	}
+
+	// Forget emitted state (new recording)
+	void ResetState()
+	{
+		lastStateMs = -1;
+		deadReckoning = new OpsTrack_DeadReckoningTrack();
+		nextSampleTick = 0;
+		lastAliveCount = -1;
+
+		// Member entity ids belong to the previous recording as well
+		if (members)
+		{
+			foreach (OpsTrack_TrackedEntity member : members)
+			{
+				member.SetEntityId(UUID.NULL_UUID);
+				member.ResetState();
+			}
+		}
+
+		if (type == OpsTrack_EntityType.VEHICLE)
+			crewDirty = true;
+	}
+
+	bool IsGroup()
+	{
+		return members != null;
+	}
+
+	// Speed in m/s (0 without physics)
+	float GetSpeed()
+	{
+		if (!physics)
+			return 0;
+		return physics.GetVelocity().Length();
+	}
+}
@@ -10,6 +10,27 @@ class OpsTrackSettings : Managed
 	bool EnableKillEvents;
 	int MaxRetries;
 	bool EnableDebug;
+	int MaxQueuedStates;         // Capacity of the ApiClient state ring buffer
+	bool EnableJournal;          // Spill batches to $profile: during backoff/shutdown and replay later
+	int MaxJournalMB;            // Disk budget for the journal
+	int MaxInFlightBatches;      // Concurrent bulk /batch requests (events have their own slot)
+	bool EnableAdaptiveFlush;    // Pick flush interval/batch size from queue depth and latency
+	string ProbeEndpoint;        // GET path used to check if the API is back after failures
+	int EventFlushIntervalMs;    // Max delay before combat/connection events are sent
+	bool EnableColumnarStates;   // Send states as parallel arrays when the API supports it
+	bool EnableDeltaStates;      // Send quantized position deltas with periodic keyframes when the API supports it
+	bool EnableStringTable;      // Send names, factions and weapons once per mission and reference them by id
+	bool EnableStateDeadband;    // Only send states that can't be extrapolated from the previous one
+	float DeadbandDistanceM;     // Extrapolation error (meters) that triggers a new state
+	float DeadbandAngleDeg;      // Heading change (degrees) that triggers a new state
+	int MaxStateIntervalS;       // A state is sent at least this often per entity
+	bool EnableSlicedCapture;    // Spread each position capture over several frames
+	int MaxCapturesPerFrame;     // Players captured per frame in sliced mode
+	bool EnableVehicleTracking;  // Track vehicle positions and crew seats
+	bool EnableAiTracking;       // Track AI groups as aggregates, members individually when it matters
+	float AiDetailDistanceM;     // AI members within this range of a player are tracked individually
+	bool EnableKillCam;          // Attach 10 Hz movement of killer and victim to kill events
+	int WoundedCoalesceWindowMs; // Hits of one actor/victim pair within this window become one wounded event
 
 	// --- Constructor with defaults ---
 	void OpsTrackSettings()
@@ -20,6 +41,27 @@ class OpsTrackSettings : Managed
 		EnableKillEvents = false;
 		MaxRetries = 20;
 		EnableDebug = false;
+		MaxQueuedStates = 5000;
+		EnableJournal = true;
+		MaxJournalMB = 64;
+		MaxInFlightBatches = 2;
+		EnableAdaptiveFlush = true;
+		ProbeEndpoint = "/health";
+		EventFlushIntervalMs = 250;
+		EnableColumnarStates = false;
+		EnableDeltaStates = false;
+		EnableStringTable = false;
+		EnableStateDeadband = true;
+		DeadbandDistanceM = 1.0;
+		DeadbandAngleDeg = 10.0;
+		MaxStateIntervalS = 10;
+		EnableSlicedCapture = true;
+		MaxCapturesPerFrame = 16;
+		EnableVehicleTracking = true;
+		EnableAiTracking = true;
+		AiDetailDistanceM = 300.0;
+		EnableKillCam = true;
+		WoundedCoalesceWindowMs = 1000;
 	}
 
 	// --- Load fields ---
@@ -34,6 +76,7 @@ class OpsTrackSettings : Managed
 		string s;
 		bool b;
 		int i;
+		float f;
 		
 		if (ctx.ReadValue("ApiBaseUrl", s))
 			ApiBaseUrl = s;
@@ -53,6 +96,69 @@ class OpsTrackSettings : Managed
 		if (ctx.ReadValue("EnableDebug", b))
 			EnableDebug = b;
 
+		if (ctx.ReadValue("MaxQueuedStates", i))
+			MaxQueuedStates = i;
+
+		if (ctx.ReadValue("EnableJournal", b))
+			EnableJournal = b;
+
+		if (ctx.ReadValue("MaxJournalMB", i))
+			MaxJournalMB = i;
+
+		if (ctx.ReadValue("MaxInFlightBatches", i))
+			MaxInFlightBatches = i;
+
+		if (ctx.ReadValue("EnableAdaptiveFlush", b))
+			EnableAdaptiveFlush = b;
+
+		if (ctx.ReadValue("ProbeEndpoint", s))
+			ProbeEndpoint = s;
+
+		if (ctx.ReadValue("EventFlushIntervalMs", i))
+			EventFlushIntervalMs = i;
+
+		if (ctx.ReadValue("EnableColumnarStates", b))
+			EnableColumnarStates = b;
+
+		if (ctx.ReadValue("EnableDeltaStates", b))
+			EnableDeltaStates = b;
+
+		if (ctx.ReadValue("EnableStringTable", b))
+			EnableStringTable = b;
+
+		if (ctx.ReadValue("EnableStateDeadband", b))
+			EnableStateDeadband = b;
+
+		if (ctx.ReadValue("DeadbandDistanceM", f))
+			DeadbandDistanceM = f;
+
+		if (ctx.ReadValue("DeadbandAngleDeg", f))
+			DeadbandAngleDeg = f;
+
+		if (ctx.ReadValue("MaxStateIntervalS", i))
+			MaxStateIntervalS = i;
+
+		if (ctx.ReadValue("EnableSlicedCapture", b))
+			EnableSlicedCapture = b;
+
+		if (ctx.ReadValue("MaxCapturesPerFrame", i))
+			MaxCapturesPerFrame = i;
+
+		if (ctx.ReadValue("EnableVehicleTracking", b))
+			EnableVehicleTracking = b;
+
+		if (ctx.ReadValue("EnableAiTracking", b))
+			EnableAiTracking = b;
+
+		if (ctx.ReadValue("AiDetailDistanceM", f))
+			AiDetailDistanceM = f;
+
+		if (ctx.ReadValue("EnableKillCam", b))
+			EnableKillCam = b;
+
+		if (ctx.ReadValue("WoundedCoalesceWindowMs", i))
+			WoundedCoalesceWindowMs = i;
+
 		// FIX: Don't log API key for security
 		OpsTrackLogger.Debug(string.Format(
 			"Settings loaded: ApiBaseUrl=%1, EnableConnectionEvents=%2, EnableKillEvents=%3, MaxRetries=%4, EnableDebug=%5",
@@ -81,6 +187,27 @@ class OpsTrackSettings : Managed
 		ctx.WriteValue("EnableKillEvents", EnableKillEvents);
 		ctx.WriteValue("MaxRetries", MaxRetries);
 		ctx.WriteValue("EnableDebug", EnableDebug);
+		ctx.WriteValue("MaxQueuedStates", MaxQueuedStates);
+		ctx.WriteValue("EnableJournal", EnableJournal);
+		ctx.WriteValue("MaxJournalMB", MaxJournalMB);
+		ctx.WriteValue("MaxInFlightBatches", MaxInFlightBatches);
+		ctx.WriteValue("EnableAdaptiveFlush", EnableAdaptiveFlush);
+		ctx.WriteValue("ProbeEndpoint", ProbeEndpoint);
+		ctx.WriteValue("EventFlushIntervalMs", EventFlushIntervalMs);
+		ctx.WriteValue("EnableColumnarStates", EnableColumnarStates);
+		ctx.WriteValue("EnableDeltaStates", EnableDeltaStates);
+		ctx.WriteValue("EnableStringTable", EnableStringTable);
+		ctx.WriteValue("EnableStateDeadband", EnableStateDeadband);
+		ctx.WriteValue("DeadbandDistanceM", DeadbandDistanceM);
+		ctx.WriteValue("DeadbandAngleDeg", DeadbandAngleDeg);
+		ctx.WriteValue("MaxStateIntervalS", MaxStateIntervalS);
+		ctx.WriteValue("EnableSlicedCapture", EnableSlicedCapture);
+		ctx.WriteValue("MaxCapturesPerFrame", MaxCapturesPerFrame);
+		ctx.WriteValue("EnableVehicleTracking", EnableVehicleTracking);
+		ctx.WriteValue("EnableAiTracking", EnableAiTracking);
+		ctx.WriteValue("AiDetailDistanceM", AiDetailDistanceM);
+		ctx.WriteValue("EnableKillCam", EnableKillCam);
+		ctx.WriteValue("WoundedCoalesceWindowMs", WoundedCoalesceWindowMs);
 
 		// FIX: Don't log API key for security
 		OpsTrackLogger.Debug(string.Format(
@@ -120,6 +247,114 @@ class OpsTrackSettings : Managed
 			MaxRetries = 100;
 		}
 		
+		if (MaxQueuedStates < 500)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxQueuedStates is below one batch, using 500");
+			MaxQueuedStates = 500;
+		}
+
+		if (MaxQueuedStates > 100000)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxQueuedStates is very high, capping at 100000");
+			MaxQueuedStates = 100000;
+		}
+
+		if (MaxJournalMB < 8)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxJournalMB is too small, using 8");
+			MaxJournalMB = 8;
+		}
+
+		if (MaxJournalMB > 1024)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxJournalMB is very high, capping at 1024");
+			MaxJournalMB = 1024;
+		}
+
+		if (!ProbeEndpoint || ProbeEndpoint == "")
+		{
+			OpsTrackLogger.Warn("Settings warning: ProbeEndpoint is empty, using /health");
+			ProbeEndpoint = "/health";
+		}
+
+		if (MaxInFlightBatches < 1 || MaxInFlightBatches > 2)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxInFlightBatches must be between 1 and 2, using 2");
+			MaxInFlightBatches = 2;
+		}
+
+		if (EventFlushIntervalMs < 100)
+		{
+			OpsTrackLogger.Warn("Settings warning: EventFlushIntervalMs is too low, using 100");
+			EventFlushIntervalMs = 100;
+		}
+
+		if (EventFlushIntervalMs > 3000)
+		{
+			OpsTrackLogger.Warn("Settings warning: EventFlushIntervalMs is very high, capping at 3000");
+			EventFlushIntervalMs = 3000;
+		}
+
+		if (DeadbandDistanceM < 0.1 || DeadbandDistanceM > 50)
+		{
+			OpsTrackLogger.Warn("Settings warning: DeadbandDistanceM must be between 0.1 and 50, using 1");
+			DeadbandDistanceM = 1.0;
+		}
+
+		if (DeadbandAngleDeg < 1 || DeadbandAngleDeg > 90)
+		{
+			OpsTrackLogger.Warn("Settings warning: DeadbandAngleDeg must be between 1 and 90, using 10");
+			DeadbandAngleDeg = 10.0;
+		}
+
+		if (MaxStateIntervalS < 1)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxStateIntervalS is too low, using 1");
+			MaxStateIntervalS = 1;
+		}
+
+		if (MaxStateIntervalS > 60)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxStateIntervalS is very high, capping at 60");
+			MaxStateIntervalS = 60;
+		}
+
+		if (MaxCapturesPerFrame < 1)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxCapturesPerFrame is too low, using 1");
+			MaxCapturesPerFrame = 1;
+		}
+
+		if (MaxCapturesPerFrame > 256)
+		{
+			OpsTrackLogger.Warn("Settings warning: MaxCapturesPerFrame is very high, capping at 256");
+			MaxCapturesPerFrame = 256;
+		}
+
+		if (AiDetailDistanceM < 0)
+		{
+			OpsTrackLogger.Warn("Settings warning: AiDetailDistanceM is negative, using 0");
+			AiDetailDistanceM = 0;
+		}
+
+		if (AiDetailDistanceM > 2000)
+		{
+			OpsTrackLogger.Warn("Settings warning: AiDetailDistanceM is very high, capping at 2000");
+			AiDetailDistanceM = 2000;
+		}
+
+		if (WoundedCoalesceWindowMs < 0)
+		{
+			OpsTrackLogger.Warn("Settings warning: WoundedCoalesceWindowMs is negative, using 0");
+			WoundedCoalesceWindowMs = 0;
+		}
+
+		if (WoundedCoalesceWindowMs > 10000)
+		{
+			OpsTrackLogger.Warn("Settings warning: WoundedCoalesceWindowMs is very high, capping at 10000");
+			WoundedCoalesceWindowMs = 10000;
+		}
+
 		return true;
 	}
 }
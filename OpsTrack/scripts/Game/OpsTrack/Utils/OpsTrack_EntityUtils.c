@@ -1,37 +1,40 @@
 // OpsTrack_EntityUtils.c
 // Shared utility functions for entity resolution
 // Eliminates code duplication between CombatEventSender and CharacterDamageManagerComponent
+// Results are memoized per entity (see OpsTrack_ResolvedEntity)
+
+// Per-entity resolution results, filled on first use
+class OpsTrack_ResolvedEntity
+{
+	EntityID entityId;   // Identifies the entity the entry was made for - a new entity can reuse the address
+	string name;
+	FactionAffiliationComponent factionAffiliation;  // Faction itself is read live, so faction changes need no invalidation
+	CharacterWeaponManagerComponent weaponManager;
+	bool componentsResolved;
+}
 
 class OpsTrack_EntityUtils
 {
+	// Memoized names and component handles. Invalidated on spawn, possession change (the player name
+	// moves with the controlled entity) and destruction; an entry whose EntityID doesn't match the entity
+	// it is looked up for (address reused after a deletion) is started over. Cleared past MAX_CACHED.
+	protected static ref map<IEntity, ref OpsTrack_ResolvedEntity> s_Cache;
+	protected static int s_Hits;
+	protected static int s_Misses;
+
+	private static const int MAX_CACHED = 2048;
+
 	// Resolves character name from entity
 	// Priority: Player name > Editable entity display name > Entity name > "Environment"
 	static string ResolveCharacterName(IEntity entity)
 	{
 		if (!entity)
 			return "Environment";
-	
-		int playerId = SCR_PossessingManagerComponent.GetPlayerIdFromControlledEntity(entity);
-		if (playerId > 0)
-		{
-			string playerName = GetGame().GetPlayerManager().GetPlayerName(playerId);
-			if (playerName && playerName != "")
-				return playerName;
-		}
-	
-		SCR_EditableEntityComponent entityComp = SCR_EditableEntityComponent.Cast(entity.FindComponent(SCR_EditableEntityComponent));
-		if (entityComp)
-		{
-			string displayName = entityComp.GetDisplayName();
-			if (displayName && displayName != "")
-				return displayName;
-		}
-	
-		string entityName = entity.GetName();
-		if (entityName && entityName != "")
-			return entityName;
-		
-		return "Unknown";
+
+		OpsTrack_ResolvedEntity resolved = GetResolved(entity);
+		if (resolved.name == "")
+			resolved.name = LookupCharacterName(entity);
+		return resolved.name;
 	}
 
 	// Resolves weapon name from instigator
@@ -44,8 +47,8 @@ class OpsTrack_EntityUtils
 		if (!ent)
 			return "Unknown";
 	
-		// Try infantry weapon
-		CharacterWeaponManagerComponent weapMgr = CharacterWeaponManagerComponent.Cast(ent.FindComponent(CharacterWeaponManagerComponent));
+		// Try infantry weapon (current weapon changes, the manager is cached)
+		CharacterWeaponManagerComponent weapMgr = GetResolvedComponents(ent).weaponManager;
 		if (weapMgr)
 		{
 			BaseWeaponComponent weapon = weapMgr.GetCurrentWeapon();
@@ -70,12 +73,116 @@ class OpsTrack_EntityUtils
 		if (!entity)
 			return GetFactionFromPlayerID(playerID);
 		
-		FactionAffiliationComponent factionAffiliation = FactionAffiliationComponent.Cast(entity.FindComponent(FactionAffiliationComponent));
+		FactionAffiliationComponent factionAffiliation = GetResolvedComponents(entity).factionAffiliation;
 		if (!factionAffiliation)
 			return GetFactionFromPlayerID(playerID);
 		
 		return factionAffiliation.GetAffiliatedFaction();
 	}
+
+	// Forget what was resolved for an entity (spawn, possession change, destroyed)
+	static void Invalidate(IEntity entity)
+	{
+		if (entity && s_Cache)
+			s_Cache.Remove(entity);
+	}
+
+	// New mission: drop everything and restart the counters
+	static void ResetCache()
+	{
+		if (s_Cache)
+			s_Cache.Clear();
+		s_Hits = 0;
+		s_Misses = 0;
+	}
+
+	static int GetCacheHits()
+	{
+		return s_Hits;
+	}
+
+	static int GetCacheMisses()
+	{
+		return s_Misses;
+	}
+
+	static string GetCacheReport()
+	{
+		int lookups = s_Hits + s_Misses;
+		int hitRate = 0;
+		if (lookups > 0)
+			hitRate = Math.Round(s_Hits * 100.0 / lookups);
+
+		int cached = 0;
+		if (s_Cache)
+			cached = s_Cache.Count();
+
+		return string.Format("Entity resolution cache: %1 hits, %2 misses (%3%), %4 entities cached", s_Hits, s_Misses, hitRate, cached);
+	}
+
+	protected static OpsTrack_ResolvedEntity GetResolved(IEntity entity)
+	{
+		if (!s_Cache)
+			s_Cache = new map<IEntity, ref OpsTrack_ResolvedEntity>();
+
+		EntityID entityId = entity.GetID();
+		OpsTrack_ResolvedEntity resolved = s_Cache.Get(entity);
+		if (resolved && resolved.entityId == entityId)
+		{
+			s_Hits++;
+			return resolved;
+		}
+
+		s_Misses++;
+
+		// Deleted entities leave stale keys behind - start over instead of tracking lifetimes
+		if (s_Cache.Count() >= MAX_CACHED)
+			s_Cache.Clear();
+
+		resolved = new OpsTrack_ResolvedEntity();
+		resolved.entityId = entityId;
+		s_Cache.Set(entity, resolved);
+		return resolved;
+	}
+
+	protected static OpsTrack_ResolvedEntity GetResolvedComponents(IEntity entity)
+	{
+		OpsTrack_ResolvedEntity resolved = GetResolved(entity);
+		if (!resolved.componentsResolved)
+		{
+			resolved.factionAffiliation = FactionAffiliationComponent.Cast(entity.FindComponent(FactionAffiliationComponent));
+			resolved.weaponManager = CharacterWeaponManagerComponent.Cast(entity.FindComponent(CharacterWeaponManagerComponent));
+
+			// Nothing found (entity still being set up) - look again next time instead of caching nulls
+			resolved.componentsResolved = resolved.factionAffiliation != null || resolved.weaponManager != null;
+		}
+		return resolved;
+	}
+
+	protected static string LookupCharacterName(IEntity entity)
+	{
+		int playerId = SCR_PossessingManagerComponent.GetPlayerIdFromControlledEntity(entity);
+		if (playerId > 0)
+		{
+			string playerName = GetGame().GetPlayerManager().GetPlayerName(playerId);
+			if (playerName && playerName != "")
+				return playerName;
+		}
+	
+		SCR_EditableEntityComponent entityComp = SCR_EditableEntityComponent.Cast(entity.FindComponent(SCR_EditableEntityComponent));
+		if (entityComp)
+		{
+			string displayName = entityComp.GetDisplayName();
+			if (displayName && displayName != "")
+				return displayName;
+		}
+	
+		string entityName = entity.GetName();
+		if (entityName && entityName != "")
+			return entityName;
+		
+		return "Unknown";
+	}
 	
 	// Gets faction from player ID
 	static Faction GetFactionFromPlayerID(int playerID)
@@ -0,0 +1,243 @@
+// OpsTrack_JsonWriter.c
+// Streaming JSON writer on top of OpsTrack_PayloadWriter
+// Values go straight into the batch buffer: strings are escaped in one pass (unchanged runs are
+// appended as they are), floats are written with a fixed number of decimals.
+// Commas are handled inside containers opened through the writer; at the top level the caller
+// separates values itself (records are written one after another into a batch array).
+
+class OpsTrack_JsonWriter
+{
+	protected ref OpsTrack_PayloadWriter m_Out;
+	protected ref array<bool> m_IsArray;    // Open containers, innermost last
+	protected ref array<bool> m_HasValue;   // Whether the container already holds a value
+
+	// Shared precision for payload numbers
+	static const int POSITION_DECIMALS = 2;  // Centimeters (same resolution as the delta encoding)
+	static const int ANGLE_DECIMALS = 1;     // Tenths of a degree
+	static const int DAMAGE_DECIMALS = 2;
+
+	private static const string HEX_DIGITS = "0123456789abcdef";
+
+	// out: buffer to write into (a private one is created if null)
+	void OpsTrack_JsonWriter(OpsTrack_PayloadWriter out = null)
+	{
+		m_IsArray = new array<bool>();
+		m_HasValue = new array<bool>();
+		SetOutput(out);
+	}
+
+	// Write into another buffer (open containers are forgotten)
+	void SetOutput(OpsTrack_PayloadWriter out)
+	{
+		m_Out = out;
+		if (!m_Out)
+			m_Out = new OpsTrack_PayloadWriter();
+
+		m_IsArray.Clear();
+		m_HasValue.Clear();
+	}
+
+	OpsTrack_PayloadWriter GetOutput()
+	{
+		return m_Out;
+	}
+
+	// Text of the private buffer (writers created without an output)
+	string Finish()
+	{
+		m_IsArray.Clear();
+		m_HasValue.Clear();
+		return m_Out.Finish();
+	}
+
+	// --- Containers (key is ignored for array elements and at the top level) ---
+
+	void BeginObject(string key = "")
+	{
+		WriteKey(key);
+		m_Out.Append("{");
+		m_IsArray.Insert(false);
+		m_HasValue.Insert(false);
+	}
+
+	void EndObject()
+	{
+		CloseContainer();
+		m_Out.Append("}");
+	}
+
+	void BeginArray(string key = "")
+	{
+		WriteKey(key);
+		m_Out.Append("[");
+		m_IsArray.Insert(true);
+		m_HasValue.Insert(false);
+	}
+
+	void EndArray()
+	{
+		CloseContainer();
+		m_Out.Append("]");
+	}
+
+	// --- Values ---
+
+	// Any text - escaped
+	void WriteString(string key, string value)
+	{
+		WriteKey(key);
+		AppendEscaped(m_Out, value);
+	}
+
+	// Generated ids (UUIDs, identity ids) - quoted without escaping
+	void WriteId(string key, string value)
+	{
+		WriteKey(key);
+		m_Out.AppendQuoted(value);
+	}
+
+	void WriteInt(string key, int value)
+	{
+		WriteKey(key);
+		m_Out.Append(value.ToString());
+	}
+
+	void WriteFloat(string key, float value, int decimals)
+	{
+		WriteKey(key);
+		m_Out.Append(FormatFixed(value, decimals));
+	}
+
+	void WriteBool(string key, bool value)
+	{
+		WriteKey(key);
+		if (value)
+			m_Out.Append("true");
+		else
+			m_Out.Append("false");
+	}
+
+	void WriteNull(string key)
+	{
+		WriteKey(key);
+		m_Out.Append("null");
+	}
+
+	// Value that is already JSON
+	void WriteRaw(string key, string json)
+	{
+		WriteKey(key);
+		m_Out.Append(json);
+	}
+
+	// --- Helpers ---
+
+	// Quoted, escaped JSON string straight into a payload buffer
+	static void AppendEscaped(OpsTrack_PayloadWriter out, string text)
+	{
+		out.Append("\"");
+
+		int length = text.Length();
+		int runStart = 0;
+		for (int i = 0; i < length; i++)
+		{
+			string escaped = EscapeChar(text.Get(i));
+			if (escaped == "")
+				continue;
+
+			if (i > runStart)
+				out.Append(text.Substring(runStart, i - runStart));
+			out.Append(escaped);
+			runStart = i + 1;
+		}
+
+		// Common case: nothing to escape, the text goes in as is
+		if (runStart == 0)
+			out.Append(text);
+		else if (runStart < length)
+			out.Append(text.Substring(runStart, length - runStart));
+
+		out.Append("\"");
+	}
+
+	// value rounded to decimals places, without exponent ("-12.50", "3")
+	static string FormatFixed(float value, int decimals)
+	{
+		int scale = 1;
+		for (int d = 0; d < decimals; d++)
+		{
+			scale *= 10;
+		}
+
+		int scaled = Math.Round(value * scale);
+		string sign = "";
+		if (scaled < 0)
+		{
+			sign = "-";
+			scaled = -scaled;
+		}
+
+		string text = sign + (scaled / scale).ToString();
+		if (decimals <= 0)
+			return text;
+
+		string fraction = (scaled % scale).ToString();
+		while (fraction.Length() < decimals)
+		{
+			fraction = "0" + fraction;
+		}
+
+		return text + "." + fraction;
+	}
+
+	// Escape sequence for one character, "" if it can be written as is
+	protected static string EscapeChar(string c)
+	{
+		if (c == "\"")
+			return "\\\"";
+		if (c == "\\")
+			return "\\\\";
+
+		// Bytes of multi-byte UTF-8 characters come back negative or >= 128 - those are valid as is
+		int code = c.ToAscii();
+		if (code < 0 || code >= 32)
+			return "";
+
+		if (code == 10)
+			return "\\n";
+		if (code == 13)
+			return "\\r";
+		if (code == 9)
+			return "\\t";
+
+		return "\\u00" + HEX_DIGITS.Get(code / 16) + HEX_DIGITS.Get(code % 16);
+	}
+
+	// Comma (if the container has a value) and "key": (unless in an array or at the top level)
+	protected void WriteKey(string key)
+	{
+		int depth = m_HasValue.Count();
+		if (depth == 0)
+			return;
+
+		if (m_HasValue[depth - 1])
+			m_Out.Append(",");
+		m_HasValue[depth - 1] = true;
+
+		if (m_IsArray[depth - 1])
+			return;
+
+		m_Out.AppendQuoted(key);
+		m_Out.Append(":");
+	}
+
+	protected void CloseContainer()
+	{
+		int depth = m_HasValue.Count();
+		if (depth == 0)
+			return;
+
+		m_IsArray.Remove(depth - 1);
+		m_HasValue.Remove(depth - 1);
+	}
+}
@@ -0,0 +1,77 @@
+// OpsTrack_MissionClock.c
+// Mission-relative time in milliseconds, based on the engine tick count
+// Kept in integer milliseconds throughout - a float world time is coarser than 1 ms after ~4.6 h of uptime.
+// Started with the recording; the UTC anchor is sent once in the mission-start payload
+// so the API can turn any timestamp back into wall-clock time.
+// Outside a recording, times are relative to the session clock instead (anchored on first use);
+// its anchor goes with every batch that has no mission.
+
+class OpsTrack_MissionClock
+{
+	protected static int s_StartTick;
+	protected static string s_AnchorUtc;
+	protected static bool s_Running;
+	protected static int s_SessionStartTick;
+	protected static string s_SessionAnchorUtc;
+
+	// Anchor the clock (called from StartRecording)
+	static void Start()
+	{
+		s_StartTick = System.GetTickCount();
+		s_AnchorUtc = OpsTrack_DateTime.ToISO8601UTC();
+		s_Running = true;
+	}
+
+	static void Stop()
+	{
+		s_Running = false;
+	}
+
+	static bool IsRunning()
+	{
+		return s_Running;
+	}
+
+	// ISO8601 UTC time of mission time 0
+	static string GetAnchorUtc()
+	{
+		return s_AnchorUtc;
+	}
+
+	// ISO8601 UTC time of session time 0
+	static string GetSessionAnchorUtc()
+	{
+		StartSession();
+		return s_SessionAnchorUtc;
+	}
+
+	// Milliseconds since the mission started, or since the session started when not recording
+	static int NowMs()
+	{
+		if (!s_Running)
+		{
+			StartSession();
+			return ElapsedSince(s_SessionStartTick);
+		}
+
+		return ElapsedSince(s_StartTick);
+	}
+
+	protected static void StartSession()
+	{
+		if (s_SessionAnchorUtc != "")
+			return;
+
+		s_SessionStartTick = System.GetTickCount();
+		s_SessionAnchorUtc = OpsTrack_DateTime.ToISO8601UTC();
+	}
+
+	protected static int ElapsedSince(int startTick)
+	{
+		// Difference of two tick counts stays correct across the int wrap-around
+		int elapsed = System.GetTickCount() - startTick;
+		if (elapsed < 0)
+			return 0;
+		return elapsed;
+	}
+}
@@ -0,0 +1,76 @@
+// OpsTrack_ObjectPool.c
+// Free list for objects created and dropped at a steady rate (states, combat events, hit summaries)
+// Typed subclasses allocate and initialize; the base class only recycles and counts.
+// The counters show per subsystem how much of the steady state still allocates.
+
+class OpsTrack_ObjectPool
+{
+	protected string m_Name;
+	protected ref array<ref Class> m_Free;
+	protected int m_MaxFree;     // Objects beyond this are left to the garbage collector
+
+	// Counters (since the last report)
+	protected int m_Allocated;   // Acquires that found the free list empty
+	protected int m_Reused;
+	protected int m_Discarded;   // Releases that found the free list full
+
+	void OpsTrack_ObjectPool(string name, int maxFree)
+	{
+		m_Name = name;
+		m_MaxFree = maxFree;
+		m_Free = new array<ref Class>();
+		m_Allocated = 0;
+		m_Reused = 0;
+		m_Discarded = 0;
+	}
+
+	// Give an object back - the caller must not use it afterwards
+	void Release(Class obj)
+	{
+		if (!obj)
+			return;
+
+		if (m_Free.Count() >= m_MaxFree)
+		{
+			m_Discarded++;
+			return;
+		}
+
+		m_Free.Insert(obj);
+	}
+
+	int GetFreeCount()
+	{
+		return m_Free.Count();
+	}
+
+	// "<name> pool: N allocated, M reused, ..." since the last call, "" if the pool wasn't used
+	string TakeReport()
+	{
+		if (m_Allocated == 0 && m_Reused == 0)
+			return "";
+
+		string report = string.Format("%1 pool: %2 allocated, %3 reused, %4 discarded, %5 free",
+			m_Name, m_Allocated, m_Reused, m_Discarded, m_Free.Count());
+		m_Allocated = 0;
+		m_Reused = 0;
+		m_Discarded = 0;
+		return report;
+	}
+
+	// Recycled object, or null if the subclass has to allocate one
+	protected Class TakeFree()
+	{
+		int last = m_Free.Count() - 1;
+		if (last < 0)
+		{
+			m_Allocated++;
+			return null;
+		}
+
+		Class obj = m_Free[last];
+		m_Free.Remove(last);
+		m_Reused++;
+		return obj;
+	}
+}
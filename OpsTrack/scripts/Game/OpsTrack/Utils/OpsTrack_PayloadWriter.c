@@ -0,0 +1,151 @@
+// OpsTrack_PayloadWriter.c
+// Chunked string builder for large request bodies
+// Small appends go into a bounded tail chunk, full chunks are merged pairwise in Finish().
+// Every byte is copied O(log chunks) times instead of once per appended item.
+
+class OpsTrack_PayloadWriter
+{
+	protected ref array<string> m_Chunks;
+	protected string m_Tail;
+	protected int m_TailLength;
+	protected int m_Length;
+	protected int m_ChunkSize;
+
+	private static const int DEFAULT_CHUNK_SIZE = 4096; // Bytes per chunk before it is sealed
+
+	void OpsTrack_PayloadWriter(int chunkSize = DEFAULT_CHUNK_SIZE)
+	{
+		m_Chunks = new array<string>();
+		m_ChunkSize = chunkSize;
+		if (m_ChunkSize < 64)
+			m_ChunkSize = 64;
+
+		Reset();
+	}
+
+	// Discard all written data (keeps the chunk array allocation)
+	void Reset()
+	{
+		m_Chunks.Clear();
+		m_Tail = "";
+		m_TailLength = 0;
+		m_Length = 0;
+	}
+
+	// Append raw text
+	void Append(string text)
+	{
+		int len = text.Length();
+		if (len == 0)
+			return;
+
+		m_Length += len;
+
+		// Seal the tail before it grows past the chunk size
+		if (m_TailLength > 0 && m_TailLength + len > m_ChunkSize)
+			SealTail();
+
+		// Large pieces become their own chunk instead of being copied into the tail
+		if (len >= m_ChunkSize)
+		{
+			m_Chunks.Insert(text);
+			return;
+		}
+
+		m_Tail += text;
+		m_TailLength += len;
+	}
+
+	// Append a quoted JSON string value without escaping (ids and keys - other text goes through OpsTrack_JsonWriter)
+	void AppendQuoted(string text)
+	{
+		Append("\"");
+		Append(text);
+		Append("\"");
+	}
+
+	// Cut the text back to length characters (undo the last appends)
+	// Sealed chunks are reopened as the tail when the cut reaches into them
+	void Truncate(int length)
+	{
+		if (length < 0)
+			length = 0;
+
+		int drop = m_Length - length;
+		while (drop > 0)
+		{
+			if (m_TailLength == 0)
+			{
+				int last = m_Chunks.Count() - 1;
+				m_Tail = m_Chunks[last];
+				m_TailLength = m_Tail.Length();
+				m_Chunks.Remove(last);
+				continue;
+			}
+
+			if (drop >= m_TailLength)
+			{
+				drop -= m_TailLength;
+				m_Length -= m_TailLength;
+				m_Tail = "";
+				m_TailLength = 0;
+				continue;
+			}
+
+			m_TailLength -= drop;
+			m_Tail = m_Tail.Substring(0, m_TailLength);
+			m_Length -= drop;
+			drop = 0;
+		}
+	}
+
+	// Total number of characters written so far
+	int Length()
+	{
+		return m_Length;
+	}
+
+	bool IsEmpty()
+	{
+		return m_Length == 0;
+	}
+
+	// Assemble the final string and reset the writer
+	string Finish()
+	{
+		SealTail();
+
+		int count = m_Chunks.Count();
+		if (count == 0)
+			return "";
+
+		// Pairwise merge: log2(count) passes, each pass copies the payload once
+		while (count > 1)
+		{
+			int write = 0;
+			for (int i = 0; i < count; i += 2)
+			{
+				if (i + 1 < count)
+					m_Chunks[write] = m_Chunks[i] + m_Chunks[i + 1];
+				else
+					m_Chunks[write] = m_Chunks[i];
+				write++;
+			}
+			count = write;
+		}
+
+		string result = m_Chunks[0];
+		Reset();
+		return result;
+	}
+
+	protected void SealTail()
+	{
+		if (m_TailLength == 0)
+			return;
+
+		m_Chunks.Insert(m_Tail);
+		m_Tail = "";
+		m_TailLength = 0;
+	}
+}
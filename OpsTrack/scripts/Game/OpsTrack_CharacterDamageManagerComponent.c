@@ -15,51 +15,25 @@ modded class SCR_CharacterDamageManagerComponent
 		
 		// Safe settings check
 		OpsTrackManager manager = OpsTrackManager.GetIfExists();
-		if (!manager)
+		if (!manager || !manager.IsRecording())
 			return;
 		
-		OpsTrackSettings settings = manager.GetSettings();
-		if (!settings || !settings.EnableKillEvents)
-			return;
-
 		IEntity victim = GetOwner();
 		if (!victim)
 			return;
 
-		// Get controller to check death state
-		SCR_CharacterControllerComponent victimController = SCR_CharacterControllerComponent.Cast(victim.FindComponent(SCR_CharacterControllerComponent));
-		
 		// Skip if dead - kills are handled by GameMode callbacks
-		if (victimController && victimController.IsDead())
+		if (GetState() == EDamageState.DESTROYED)
 			return;
 
-		// Get instigator from damage context
-		Instigator instigator = damageContext.instigator;
-		if (!instigator)
-			return;
+		IEntity attacker = null;
+		if (damageContext.instigator)
+			attacker = damageContext.instigator.GetInstigatorEntity();
 
-		IEntity killerEntity = instigator.GetInstigatorEntity();
-		
-		// Skip self-harm in OnDamage - it will be caught as kill or wounded
+		// Raw record only - names, factions, weapon and JSON are resolved in batches by CombatEventSender
 		// Self-harm that doesn't kill is still a wounded event
-		
-		// Get victim player ID
-		int victimPlayerId = 0;
-		if (GetGame() && GetGame().GetPlayerManager())
-			victimPlayerId = GetGame().GetPlayerManager().GetPlayerIdFromControlledEntity(victim);
-
-		// Create context data
-		SCR_InstigatorContextData contextData = new SCR_InstigatorContextData(
-			victimPlayerId,
-			victim,
-			killerEntity,
-			instigator,
-			false
-		);
-
-		// Send wounded event (not dead, just damaged)
 		CombatEventSender sender = CombatEventSender.Get();
 		if (sender)
-			sender.SendWounded(contextData);
+			sender.RecordDamage(victim, attacker, damageContext.instigator, damageContext.damageValue, damageContext.damageType, damageContext.struckHitZone);
 	}
 }
@@ -0,0 +1,18 @@
+// OpsTrack_Vehicle.c
+// Registers vehicles with the OpsTrack entity registry as they spawn
+
+modded class Vehicle
+{
+	override void EOnInit(IEntity owner)
+	{
+		super.EOnInit(owner);
+
+		if (!Replication.IsServer())
+			return;
+
+		// Registry is independent of OpsTrackManager, so vehicles placed in the world at load time are caught too
+		OpsTrack_EntityManager entityMgr = OpsTrack_EntityManager.Get();
+		if (entityMgr)
+			entityMgr.TrackVehicle(this);
+	}
+}